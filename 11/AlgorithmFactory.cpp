@@ -8,6 +8,10 @@
 #include <cctype>
 // Include memory header for smart pointers
 #include <memory>
+// Include reorder header for the vertex order suffix
+#include "graphReorder.h"
+// Include thread helpers for the hardware thread count
+#include "graphThreads.h"
 
 using namespace std;
 
@@ -21,31 +25,57 @@ static string norm(string s){
     return s;
 }
 
-// Factory method to create an algorithm strategy based on AlgorithmKind enum
-std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::create(AlgorithmKind kind){
+// Create the strategy for kind, relabeling vertices to order before it runs
+static std::unique_ptr<AlgorithmStrategy> make(AlgorithmKind kind, VertexOrder order){
     // Switch on the kind and return the corresponding strategy
     switch (kind){
-        case AlgorithmKind::MST:             return make_unique<MSTStrategy>();
-        case AlgorithmKind::SCC:             return make_unique<SCCStrategy>();
-        case AlgorithmKind::CountCliques:    return make_unique<CountCliquesStrategy>();
-        case AlgorithmKind::MaxClique:       return make_unique<MaxCliqueStrategy>();
-        case AlgorithmKind::HasEulerCircuit: return make_unique<HasEulerCircuitStrategy>();
-        case AlgorithmKind::EulerCircuit:    return make_unique<EulerCircuitStrategy>();
+        case AlgorithmKind::MST:             return make_unique<MSTStrategy>(order);
+        case AlgorithmKind::SCC:             return make_unique<SCCStrategy>(order);
+        case AlgorithmKind::CountCliques:    return make_unique<CountCliquesStrategy>(order);
+        case AlgorithmKind::MaxClique:       return make_unique<MaxCliqueStrategy>(order);
+        case AlgorithmKind::HasEulerCircuit: return make_unique<HasEulerCircuitStrategy>(order);
+        case AlgorithmKind::EulerCircuit:    return make_unique<EulerCircuitStrategy>(order);
         default:                             return nullptr;
     }
 }
 
+// Factory method to create an algorithm strategy based on AlgorithmKind enum
+std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::create(AlgorithmKind kind){
+    return make(kind, VertexOrder::None);
+}
+
 // Factory method to create an algorithm strategy based on string name
 std::unique_ptr<AlgorithmStrategy> AlgorithmFactory::create(const std::string& name){
     // Normalize the input name
     string k = norm(name);
+    // An "@ORDER" suffix (e.g. "SCC@RCM") selects the vertex order the strategy runs in
+    VertexOrder order = VertexOrder::None;
+    size_t at = k.find('@');
+    if (at != string::npos) {
+        if (!parseVertexOrder(k.substr(at + 1), order)) return nullptr;
+        k.erase(at);
+    }
+    // "PARALLELMST" or "PARALLELMST:<threads>" (e.g. "PARALLELMST:8@RCM"): Borůvka on a thread budget
+    if (k.compare(0, 11, "PARALLELMST") == 0) {
+        int threads = 0;
+        if (k.size() > 11) {
+            if (k[11] != ':' || k.size() == 12 || k.size() > 16) return nullptr;
+            for (size_t i = 12; i < k.size(); ++i) {
+                if (!isdigit((unsigned char)k[i])) return nullptr;
+                threads = threads * 10 + (k[i] - '0');
+            }
+            // Names come from network requests: never more threads than the hardware runs
+            threads = std::min(threads, threadBudget(0));
+        }
+        return make_unique<ParallelMSTStrategy>(order, threads);
+    }
     // Match normalized name to known algorithms and create the corresponding strategy
-    if (k=="MST")               return create(AlgorithmKind::MST);
-    if (k=="SCC")               return create(AlgorithmKind::SCC);
-    if (k=="NUMOFCLIQUES")      return create(AlgorithmKind::CountCliques);
-    if (k=="MAXCLIQUE")         return create(AlgorithmKind::MaxClique);
-    if (k=="HASEULERCIRCUIT")   return create(AlgorithmKind::HasEulerCircuit);
-    if (k=="EULERCIRCUIT")      return create(AlgorithmKind::EulerCircuit);
+    if (k=="MST")               return make(AlgorithmKind::MST, order);
+    if (k=="SCC")               return make(AlgorithmKind::SCC, order);
+    if (k=="NUMOFCLIQUES")      return make(AlgorithmKind::CountCliques, order);
+    if (k=="MAXCLIQUE")         return make(AlgorithmKind::MaxClique, order);
+    if (k=="HASEULERCIRCUIT")   return make(AlgorithmKind::HasEulerCircuit, order);
+    if (k=="EULERCIRCUIT")      return make(AlgorithmKind::EulerCircuit, order);
     // Return nullptr if no match found
     return nullptr;
 }
@@ -20,23 +20,43 @@
 #include "algoSCC.h"
 // Include cliques algorithm implementation
 #include "algoCliques.h"
+// Include reorder header for relabeling vertices before a run
+#include "graphReorder.h"
 
 using std::string; using std::ostringstream;
 
 // Strategy for Minimum Spanning Tree
 std::string MSTStrategy::run(const Graph& g) {
-    // Compute MST total weight
-    long long w = algoMST::mstWeight(g);
+    // Compute MST total weight (the same in any vertex order)
+    ReorderedGraph r(g, order);
+    long long w = algoMST::mstWeight(r.graph());
     // If graph is not connected, return message
     if (w < 0) return "MST: graph is not connected (no spanning tree).";
     // Return MST total weight
     return "MST total weight = " + std::to_string(w);
 }
 
+// Strategy for Minimum Spanning Tree by parallel Borůvka
+std::string ParallelMSTStrategy::run(const Graph& g) {
+    ReorderedGraph r(g, order);
+    long long w = algoMST::mstWeight(r.graph(), MSTMethod::Boruvka, threads);
+    if (w < 0) return "MST: graph is not connected (no spanning tree).";
+    return "MST total weight = " + std::to_string(w);
+}
+
 // Strategy for Strongly Connected Components
 std::string SCCStrategy::run(const Graph& g) {
-    // Compute SCC components
-    auto comp = algoSCC::scc(g);
+    // Compute SCC components, indexed by original vertex id
+    ReorderedGraph r(g, order);
+    auto comp = r.perOriginal(algoSCC::scc(r.graph()));
+    // Component ids depend on the vertex order (Kosaraju numbers them by finish order); number
+    // them by first appearance so every order, the default one included, prints the same mapping
+    std::vector<int> rename(comp.size(), -1);
+    int next = 0;
+    for (int& c : comp) {
+        if (rename[c] < 0) rename[c] = next++;
+        c = rename[c];
+    }
     // Calculate number of components
     int num = comp.empty()? 0 : (*std::max_element(comp.begin(), comp.end()) + 1);
     ostringstream out;
@@ -50,7 +70,8 @@ std::string SCCStrategy::run(const Graph& g) {
 // Strategy for counting maximal cliques
 std::string CountCliquesStrategy::run(const Graph& g) {
     // Count maximal cliques using Bron–Kerbosch algorithm
-    long long c = algoCliques::countCliques(g);
+    ReorderedGraph r(g, order);
+    long long c = algoCliques::countCliques(r.graph());
     // Return number of maximal cliques
     return "Number of maximal cliques = " + std::to_string(c);
 }
@@ -58,7 +79,10 @@ std::string CountCliquesStrategy::run(const Graph& g) {
 // Strategy for finding maximum clique
 std::string MaxCliqueStrategy::run(const Graph& g) {
     // Find largest clique in the graph
-    auto best = algoCliques::maxClique(g);
+    ReorderedGraph r(g, order);
+    auto best = r.toOriginal(algoCliques::maxClique(r.graph()));
+    // List a relabeled clique in original id order
+    if (r.reordered()) std::sort(best.begin(), best.end());
     ostringstream out;
     // Output size of maximum clique
     out << "Maximum clique size = " << best.size() << "\n{ ";
@@ -70,7 +94,7 @@ std::string MaxCliqueStrategy::run(const Graph& g) {
 
 // Strategy for checking if Euler circuit exists
 std::string HasEulerCircuitStrategy::run(const Graph& g) {
-    // Check if graph has Euler circuit
+    // Check if graph has Euler circuit (reads only degree counters, so no order is applied)
     bool hasEulerCircuit = Algorithms::hasEulerCircuit(g);
     // Return result message
     if(hasEulerCircuit)
@@ -86,8 +110,9 @@ std::string EulerCircuitStrategy::run(const Graph& g) {
         out << "Euler circuit: NONE";
         return out.str();
     }
-    // Get Euler circuit path
-    auto path = Algorithms::eulerCircuit(g);
+    // Get Euler circuit path, in original vertex ids
+    ReorderedGraph r(g, order);
+    auto path = r.toOriginal(Algorithms::eulerCircuit(r.graph()));
     // Output length of Euler circuit
     out << "Euler circuit length = " << path.size() << "\n";
     out << "{ ";
@@ -2,45 +2,71 @@
 
 #pragma once
 #include "AlgorithmStrategy.h"
+#include "graphReorder.h"
+
+// Base of the strategies below: the vertex order the graph is relabeled to before the
+// algorithm runs (results always use the original vertex ids)
+class ReorderingStrategy : public AlgorithmStrategy {
+protected:
+    VertexOrder order;
+public:
+    explicit ReorderingStrategy(VertexOrder order = VertexOrder::None) : order(order) {}
+};
 
 // Strategy for Minimum Spanning Tree
-class MSTStrategy : public AlgorithmStrategy {
+class MSTStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run MST algorithm and return result as string
     std::string run(const Graph& g) override;
 };
 
+// Strategy for Minimum Spanning Tree by parallel Borůvka on a thread budget
+class ParallelMSTStrategy : public ReorderingStrategy {
+    int threads; // 0 = one per hardware thread
+public:
+    explicit ParallelMSTStrategy(VertexOrder order = VertexOrder::None, int threads = 0)
+        : ReorderingStrategy(order), threads(threads) {}
+    // Run parallel MST algorithm and return result as string (same text as MSTStrategy)
+    std::string run(const Graph& g) override;
+};
+
 // Strategy for Strongly Connected Components
-class SCCStrategy : public AlgorithmStrategy {
+class SCCStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run SCC algorithm and return result as string
     std::string run(const Graph& g) override;
 };
 
 // Strategy for counting maximal cliques
-class CountCliquesStrategy : public AlgorithmStrategy {
+class CountCliquesStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run clique counting algorithm and return result as string
     std::string run(const Graph& g) override;
 };
 
 // Strategy for finding maximum clique
-class MaxCliqueStrategy : public AlgorithmStrategy {
+class MaxCliqueStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run maximum clique algorithm and return result as string
     std::string run(const Graph& g) override;
 };
 
 // Strategy for checking if Euler circuit exists
-class HasEulerCircuitStrategy : public AlgorithmStrategy {
+class HasEulerCircuitStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run Euler circuit existence check and return result as string
     std::string run(const Graph& g) override;
 };
 
 // Strategy for finding Euler circuit
-class EulerCircuitStrategy : public AlgorithmStrategy {
+class EulerCircuitStrategy : public ReorderingStrategy {
 public:
+    using ReorderingStrategy::ReorderingStrategy;
     // Run Euler circuit finding algorithm and return result as string
     std::string run(const Graph& g) override;
 };
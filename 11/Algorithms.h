@@ -1,5 +1,10 @@
 #pragma once
 #include <vector>
+#include <stack>
+#include <algorithm>
+#include "graphCSR.h"
+#include "graphCompressed.h"
+#include "graphTriangular.h"
 using namespace std;
 class Graph;
 
@@ -9,11 +14,166 @@ public:
     // Returns true if the graph has an Euler circuit
     static bool hasEulerCircuit(const Graph& g);
 
-    
+
     // Returns the Euler circuit as a vector of vertices, or an empty vector if none exists
     static vector<int> eulerCircuit(const Graph& g);
 
+    // Same on the subgraph induced by vertices (e.g. one component), without copying it.
+    // The circuit is given in the vertex ids of g.
+    static bool hasEulerCircuit(const Graph& g, const vector<int>& vertices);
+    static vector<int> eulerCircuit(const Graph& g, const vector<int>& vertices);
+
+    // Same on any graph representation exposing vertexCount()/degree()/neighbors()
+    template <class G>
+    static bool hasEulerCircuit(const G& g);
+    template <class G>
+    static vector<int> eulerCircuit(const G& g);
+
 private:
-    // Helper function for DFS traversal
-    static void dfsOnEdges(const vector<vector<int>>& m, int u, vector<int>& vis);
+    // Helper function for DFS traversal (iterative)
+    template <class G>
+    static void dfsOnEdges(const G& g, int u, vector<int>& vis);
+
+    // Check that every vertex with edges is reachable from start
+    template <class G>
+    static bool connectedFrom(const G& g, int start);
+
+    // Hierholzer's algorithm on an immutable snapshot (CSRGraph or CompressedGraph),
+    // starting from vertex start
+    template <class G>
+    static vector<int> hierholzer(const G& m, int start);
 };
+
+template <class G>
+void Algorithms::dfsOnEdges(const G& g, int u, vector<int>& vis) {
+    vector<int> st{u}; // Vertices whose neighbors still have to be visited
+    vis[u] = 1; // Mark start vertex as visited
+    // A triangular matrix row is split in two; it is gathered into buf and scanned in one pass
+    vector<typename G::weight_type> buf(IsTriangular<G>::value ? g.vertexCount() : 0);
+    while (!st.empty()) {
+        int x = st.back();
+        st.pop_back();
+        if constexpr (IsTriangular<G>::value) {
+            auto row = g.row(x, buf.data());
+            for (int v = 0; v < row.size(); ++v)
+                if (row[v] != 0 && !vis[v]) {
+                    vis[v] = 1;
+                    st.push_back(v);
+                }
+            continue;
+        }
+        for (int v : g.neighbors(x)) {
+            // If there is an edge from x to v and v is not visited
+            if (!vis[v]) {
+                vis[v] = 1;
+                st.push_back(v);
+            }
+        }
+    }
+}
+
+template <class G>
+bool Algorithms::hasEulerCircuit(const G& g) {
+    int V = g.vertexCount(); // Number of vertices
+
+    // Check if all vertices have even degree, and find a starting vertex with degree > 0
+    int start = -1;
+    for (int i = 0; i < V; ++i) {
+        int deg = g.degree(i);
+        if (deg % 2 != 0)
+            return false; // If degree is odd, no Euler circuit
+        if (deg > 0 && start == -1)
+            start = i; // First vertex with edges
+    }
+    if (start == -1) {
+        // No edges in the graph, so Euler circuit exists (trivial case)
+        return true;
+    }
+
+    // Check if all non-zero degree vertices are connected
+    return connectedFrom(g, start);
+}
+
+template <class G>
+bool Algorithms::connectedFrom(const G& g, int start) {
+    vector<int> vis(g.vertexCount(), 0); // Visited array
+    dfsOnEdges(g, start, vis); // DFS from start vertex
+    for (int i = 0; i < g.vertexCount(); ++i) {
+        if (!vis[i] && g.degree(i) > 0)
+            return false; // Not all vertices are connected
+    }
+    return true; // All conditions for Euler circuit are satisfied
+}
+
+template <class G>
+vector<int> Algorithms::eulerCircuit(const G& g) {
+    if (!hasEulerCircuit(g))
+        return {}; // If no Euler circuit exists, return empty
+
+    // Find a starting vertex with degree > 0
+    int V = g.vertexCount(), start = 0;
+    for (int i = 0; i < V; ++i) {
+        if (g.degree(i) > 0) {
+            start = i;
+            break;
+        }
+    }
+    // Hierholzer consumes edges, which is done on an immutable snapshot with per-entry flags
+    if constexpr (IsFrozen<G>::value)
+        return hierholzer(g, start);
+    else
+        return hierholzer(snapshot(g), start);
+}
+
+template <class G>
+vector<int> Algorithms::hierholzer(const G& m, int start) {
+    vector<int> path; // Stores the Euler circuit
+    int V = m.vertexCount(); // Number of vertices
+    if (V == 0)
+        return path;
+
+    vector<char> used(m.entryCount(), 0); // Removed entries
+    // Per row: cursor at the first entry that may still be unused, and that entry's index.
+    // Rows are walked with their own iterators, so compressed rows are decoded only once.
+    using Range = decltype(m.neighbors(0));
+    vector<Range> cur;
+    cur.reserve(V);
+    vector<size_t> next(V);
+    for (int u = 0; u < V; ++u) {
+        cur.push_back(m.neighbors(u));
+        next[u] = m.rowStart(u);
+    }
+
+    stack<int> st; // Stack for Hierholzer's algorithm
+
+
+    st.push(start); // Begin from start vertex
+    while (!st.empty()) {
+        int u = st.top(); // Current vertex
+
+        // Skip entries of u that were already removed
+        Range& r = cur[u];
+        while (r.first != r.last && used[next[u]]) {
+            ++r.first;
+            ++next[u];
+        }
+
+        if (r.first != r.last) {
+            // Remove the edge u-v from the graph (both directions for undirected)
+            int v = *r.first;
+            used[next[u]] = 1;
+            long long back = m.find(v, u);
+            if (back >= 0)
+                used[back] = 1;
+            st.push(v); // Continue to vertex v
+        } else {
+            // No more edges from u, add u to path and backtrack
+            path.push_back(u);
+            st.pop();
+        }
+    }
+
+    reverse(path.begin(), path.end()); // Reverse to get correct circuit order
+    return path; // Return Euler circuit
+}
+
@@ -0,0 +1,68 @@
+// ===== AlignedBuffer.h =====
+#pragma once
+// Include cstring for std::memcpy
+#include <cstring>
+// Include type_traits for std::is_trivially_copyable
+#include <type_traits>
+// Include utility for std::move
+#include <utility>
+// Include the graph memory hook (huge pages / NUMA placement)
+#include "graphMemory.h"
+
+// Zero-initialized array of trivially copyable T in a single allocation aligned to a cache line.
+// Memory comes from GraphMemory, so large buffers follow its huge page / NUMA policy.
+template <typename T>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedBuffer holds plain values only");
+
+    // Allocation unit and alignment (one cache line)
+    static constexpr size_t LINE = 64;
+
+    MemoryPlacement where; // how ptr was placed (declared first: allocate() fills it in)
+    T* ptr = nullptr;
+    size_t count = 0;
+
+    // Allocate n zeroed elements, rounding the byte size up to whole cache lines
+    static T* allocate(size_t n, MemoryPlacement& where) {
+        if (n == 0) return nullptr;
+        size_t bytes = (n * sizeof(T) + LINE - 1) / LINE * LINE;
+        return static_cast<T*>(GraphMemory::allocate(bytes, where));
+    }
+
+public:
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(size_t n) : ptr(allocate(n, where)), count(n) {}
+
+    // Deep copy
+    AlignedBuffer(const AlignedBuffer& o) : ptr(allocate(o.count, where)), count(o.count) {
+        if (count) std::memcpy(ptr, o.ptr, count * sizeof(T));
+    }
+    AlignedBuffer& operator=(const AlignedBuffer& o) {
+        if (this != &o) { AlignedBuffer tmp(o); swap(tmp); }
+        return *this;
+    }
+
+    // Move steals the allocation
+    AlignedBuffer(AlignedBuffer&& o) noexcept : where(o.where), ptr(o.ptr), count(o.count) { o.ptr = nullptr; o.count = 0; }
+    AlignedBuffer& operator=(AlignedBuffer&& o) noexcept {
+        if (this != &o) { AlignedBuffer tmp(std::move(o)); swap(tmp); }
+        return *this;
+    }
+
+    ~AlignedBuffer() { GraphMemory::release(ptr, where); }
+
+    void swap(AlignedBuffer& o) noexcept {
+        std::swap(ptr, o.ptr);
+        std::swap(count, o.count);
+        std::swap(where, o.where);
+    }
+
+    // Where the elements were placed (heap, or a mapping with its page size and NUMA policy)
+    const MemoryPlacement& placement() const { return where; }
+
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    size_t size() const { return count; }
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+};
@@ -0,0 +1,38 @@
+// ===== GraphTypes.h =====
+#pragma once
+
+// Include type_traits for std::conditional/std::is_floating_point
+#include <type_traits>
+
+// Weighted edge (u -> v, weight w), used when algorithms collect edge lists
+template <class W>
+struct BasicEdge {
+    int u, v;
+    W w;
+};
+using Edge = BasicEdge<int>;
+
+// Type used to add up weights of type W (long long for integers, double for float)
+template <class W>
+using WeightSum = typename std::conditional<std::is_floating_point<W>::value, double, long long>::type;
+
+// Range of neighbors returned by neighbors(u) of every graph representation.
+// Iterating yields neighbor ids in ascending order; it.weight() gives the edge weight.
+template <class It>
+struct NeighborRange {
+    It first, last;
+    It begin() const { return first; }
+    It end() const { return last; }
+};
+
+// Read-only view of one contiguous matrix row
+template <class T>
+struct RowSpan {
+    const T* ptr;
+    int len;
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + len; }
+    const T& operator[](int j) const { return ptr[j]; }
+    int size() const { return len; }
+    const T* data() const { return ptr; }
+};
@@ -0,0 +1,18 @@
+// PipelineTypes.h
+#pragma once
+// Include string header for std::string
+#include <string>
+// Include shared graph header
+#include "graphShared.h"
+
+// Structure to represent a client request in the pipeline
+struct Request {
+    int client_fd;       // Socket file descriptor for client connection
+    SharedGraph g;       // Shared immutable graph; stages only read it, so hops never copy it
+    std::string result;  // Accumulated results for output
+    unsigned long req_id;// Unique request identifier
+
+    // Constructor: share the given graph snapshot
+    Request(int fd, SharedGraph graph, unsigned long id)
+        : client_fd(fd), g(std::move(graph)), req_id(id) {}
+};
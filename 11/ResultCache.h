@@ -0,0 +1,143 @@
+// ResultCache.h
+#pragma once
+// Include string header for std::string
+#include <string>
+// Include containers for the entries and their order
+#include <unordered_map>
+#include <list>
+// Include mutex for thread synchronization
+#include <mutex>
+// Include optional for graphs that could not be built
+#include <optional>
+// Include shared graph header
+#include "graphShared.h"
+
+// Recent graphs and the algorithm results computed on them, shared by concurrent requests.
+// Graphs are found by the request that built them (key), so a repeated request reuses the
+// materialized graph instead of building it again. Results are found by Graph::fingerprint(),
+// so any request that ends up with the same graph (another seed or spelling, a loaded file)
+// gets the stored output without the graph being scanned. The fingerprint is a hash, so a hit
+// must also match the graph's edge count; a mismatch replaces the stored results. Each map is bounded by bytes, not
+// entries (one dense graph can outweigh thousands of sparse ones): graphs by Graph::byteCount(),
+// results by the length of their outputs. The least recently used entries are dropped first; an
+// entry larger than the whole budget is never kept. An empty key means "do not cache the graph".
+class ResultCache {
+    struct FingerprintHash {
+        size_t operator()(const GraphFingerprint& f) const { return (size_t)f.lo; }
+    };
+    using Results = std::unordered_map<std::string, std::string>; // algorithm name -> output
+
+    struct GraphEntry {
+        SharedGraph g;
+        size_t bytes;
+        std::list<std::string>::iterator at; // position in graphOrder
+    };
+    struct ResultEntry {
+        Results out;
+        long long edges; // edge count of the graph, checked on every hit
+        size_t bytes;
+        std::list<GraphFingerprint>::iterator at; // position in resultOrder
+    };
+
+    std::mutex m;
+    std::unordered_map<std::string, GraphEntry> graphs;
+    std::list<std::string> graphOrder; // keys, least recently used first
+    size_t graphBytes = 0;
+    std::unordered_map<GraphFingerprint, ResultEntry, FingerprintHash> results;
+    std::list<GraphFingerprint> resultOrder; // fingerprints, least recently used first
+    size_t resultBytes = 0;
+    size_t maxGraphBytes, maxResultBytes;
+
+    // Drop least recently used graphs until the rest fit the budget
+    void trimGraphs() {
+        while (graphBytes > maxGraphBytes) {
+            auto it = graphs.find(graphOrder.front());
+            graphBytes -= it->second.bytes;
+            graphs.erase(it);
+            graphOrder.pop_front();
+        }
+    }
+
+    // Drop least recently used result sets until the rest fit the budget
+    void trimResults() {
+        while (resultBytes > maxResultBytes) {
+            auto it = results.find(resultOrder.front());
+            resultBytes -= it->second.bytes;
+            results.erase(it);
+            resultOrder.pop_front();
+        }
+    }
+
+public:
+    explicit ResultCache(size_t maxGraphBytes = size_t(1) << 30, size_t maxResultBytes = size_t(16) << 20)
+        : maxGraphBytes(maxGraphBytes), maxResultBytes(maxResultBytes) {}
+
+    // Graph cached under key, or the one make(Graph&) builds (then cached).
+    // make returns false if the graph cannot be built.
+    template <class F>
+    std::optional<SharedGraph> graph(const std::string& key, F make) {
+        if (!key.empty()) {
+            std::lock_guard<std::mutex> lk(m);
+            auto it = graphs.find(key);
+            if (it != graphs.end()) {
+                graphOrder.splice(graphOrder.end(), graphOrder, it->second.at);
+                return it->second.g;
+            }
+        }
+        // Build outside the lock; two requests racing on one key both build, the first is kept
+        Graph built(1);
+        if (!make(built)) return std::nullopt;
+        SharedGraph g(std::move(built));
+        size_t bytes = g->byteCount();
+        if (key.empty() || bytes > maxGraphBytes) return g;
+        std::lock_guard<std::mutex> lk(m);
+        auto res = graphs.emplace(key, GraphEntry{g, bytes, {}});
+        if (!res.second) return res.first->second.g;
+        res.first->second.at = graphOrder.insert(graphOrder.end(), key);
+        graphBytes += bytes;
+        trimGraphs();
+        return g;
+    }
+
+    // Output of algorithm algo on g, computed by run() unless a graph with the same
+    // fingerprint already has it
+    template <class F>
+    std::string result(const Graph& g, const std::string& algo, F run) {
+        GraphFingerprint fp = g.fingerprint();
+        {
+            std::lock_guard<std::mutex> lk(m);
+            auto it = results.find(fp);
+            if (it != results.end() && it->second.edges == g.edgeCount()) {
+                auto r = it->second.out.find(algo);
+                if (r != it->second.out.end()) {
+                    resultOrder.splice(resultOrder.end(), resultOrder, it->second.at);
+                    return r->second;
+                }
+            }
+        }
+        std::string out = run();
+        size_t bytes = algo.size() + out.size();
+        if (bytes > maxResultBytes) return out;
+        std::lock_guard<std::mutex> lk(m);
+        auto res = results.emplace(fp, ResultEntry{Results{}, g.edgeCount(), 0, {}});
+        ResultEntry& e = res.first->second;
+        if (res.second) {
+            e.at = resultOrder.insert(resultOrder.end(), fp);
+        } else {
+            resultOrder.splice(resultOrder.end(), resultOrder, e.at);
+            if (e.edges != g.edgeCount()) {
+                // Another graph with the same fingerprint: its results are not ours
+                resultBytes -= e.bytes;
+                e.out.clear();
+                e.bytes = 0;
+                e.edges = g.edgeCount();
+            }
+        }
+        if (e.out.emplace(algo, out).second) {
+            e.bytes += bytes;
+            resultBytes += bytes;
+            trimResults();
+        }
+        return out;
+    }
+};
@@ -0,0 +1,135 @@
+// ===== UnionFind.h =====
+#pragma once
+// Include atomic for the concurrent variant
+#include <atomic>
+// Include cstdint for the priority hash
+#include <cstdint>
+// Include memory for std::unique_ptr
+#include <memory>
+// Include numeric for std::iota
+#include <numeric>
+// Include utility for std::swap
+#include <utility>
+// Include vector header for std::vector
+#include <vector>
+
+// Disjoint sets over 0..n-1 with union by size and path halving: near-constant amortized time
+// per operation, no recursion however long the chains. Not thread-safe (see ConcurrentUnionFind).
+class UnionFind {
+    std::vector<int> parent, sizes;
+    int sets;
+
+public:
+    explicit UnionFind(int n = 0) : parent(n), sizes(n, 1), sets(n) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    // Number of elements
+    int size() const { return (int)parent.size(); }
+
+    // Number of disjoint sets
+    int count() const { return sets; }
+
+    // Representative of the set of x; every node on the way is pointed at its grandparent
+    int find(int x) {
+        while (parent[x] != x)
+            x = parent[x] = parent[parent[x]];
+        return x;
+    }
+
+    // Whether a and b are in the same set
+    bool same(int a, int b) { return find(a) == find(b); }
+
+    // Number of elements in the set of x
+    int setSize(int x) { return sizes[find(x)]; }
+
+    // Merge the sets of a and b, the smaller under the larger; false if already one set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (sizes[a] < sizes[b])
+            std::swap(a, b);
+        parent[b] = a;
+        sizes[a] += sizes[b];
+        --sets;
+        return true;
+    }
+};
+
+// Disjoint sets that any number of threads find, test and merge at once, without locks.
+// A root is linked by one CAS on its parent, always under the root of higher priority; the
+// priorities are a hash of the element keyed by seed, so trees stay O(log n) deep in expectation
+// whatever order the threads link in. find() halves paths with CASes that may fail harmlessly
+// (another thread shortened the path first) and never retries, so it takes no more steps than
+// the path is long; unite() retries only when a root it read was linked by another thread
+// meanwhile. Set sizes and counts are not tracked: count the successful unite() calls.
+class ConcurrentUnionFind {
+    std::unique_ptr<std::atomic<int>[]> parent;
+    int n;
+    uint64_t seed;
+
+    // Priority of x: splitmix64 finalizer of x and the seed, ties broken by x
+    bool below(int x, int y) const {
+        uint64_t px = mix((uint64_t)x + seed), py = mix((uint64_t)y + seed);
+        return px != py ? px < py : x < y;
+    }
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit ConcurrentUnionFind(int n = 0, uint64_t seed = 0x9E3779B97F4A7C15ULL)
+        : parent(new std::atomic<int>[n > 0 ? n : 0]), n(n > 0 ? n : 0), seed(seed) {
+        for (int i = 0; i < this->n; ++i)
+            parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    // Number of elements
+    int size() const { return n; }
+
+    // Representative of the set of x at some moment during the call
+    int find(int x) {
+        for (;;) {
+            int p = parent[x].load(std::memory_order_acquire);
+            if (p == x)
+                return x;
+            int gp = parent[p].load(std::memory_order_acquire);
+            if (gp != p)
+                parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+            x = gp;
+        }
+    }
+
+    // Whether a and b are in the same set at some moment during the call
+    bool same(int a, int b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return true;
+            // a was still a root after b's was found: apart at that moment
+            if (parent[a].load(std::memory_order_acquire) == a)
+                return false;
+        }
+    }
+
+    // Merge the sets of a and b; false if already one set. Exactly one of several threads
+    // merging the same two sets gets true.
+    bool unite(int a, int b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return false;
+            if (below(b, a))
+                std::swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+};
@@ -1,6 +1,8 @@
 // ===== algoCliques.h =====
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <numeric>
 using namespace std;
 class Graph;
 
@@ -14,9 +16,108 @@ public:
     // 4) Maximum clique (returns the vertex indices of a maximum clique).
     static vector<int> maxClique(const Graph &g);
 
+    // Same on the subgraph induced by vertices (e.g. a neighborhood), without copying it.
+    // The clique is given in the vertex ids of g.
+    static long long countCliques(const Graph &g, const vector<int> &vertices);
+    static vector<int> maxClique(const Graph &g, const vector<int> &vertices);
+
+    // Same on any graph representation exposing vertexCount()/hasEdge()
+    template <class G>
+    static long long countCliques(const G &g);
+    template <class G>
+    static vector<int> maxClique(const G &g);
+
 private:
 
     // Bron–Kerbosch for cliques
-    static void bronKerbosch(const vector<vector<int>> &adj, vector<int> &R, vector<int> &P, vector<int> &X,
+    template <class G>
+    static void bronKerbosch(const G &adj, vector<int> &R, vector<int> &P, vector<int> &X,
                              long long &count, vector<int> &best);
-};
\ No newline at end of file
+};
+
+// Bron–Kerbosch recursive algorithm for finding maximal cliques
+template <class G>
+void algoCliques::bronKerbosch(const G &adj, vector<int> &R, vector<int> &P, vector<int> &X,
+                               long long &count, vector<int> &best)
+{
+    // If both P and X are empty, R is a maximal clique
+    if (P.empty() && X.empty())
+    {
+        // Increment count of maximal cliques
+        count++; // counting maximal cliques; to count all cliques you would enumerate subsets differently
+        // Update best clique if current clique is larger
+        if ((int)R.size() > (int)best.size())
+            best = R;
+        return;
+    }
+    // Choose a pivot u from P∪X to reduce branches
+    int u = !P.empty() ? P[0] : (!X.empty() ? X[0] : -1);
+    // Compute P \ N(u)
+    vector<int> PwithoutNu;
+    if (u == -1)
+        PwithoutNu = P;
+    else
+    {
+        for (int v : P)
+            if (!adj.hasEdge(u, v))
+                PwithoutNu.push_back(v);
+    }
+    // Iterate over vertices in P \ N(u)
+    for (int v : PwithoutNu)
+    {
+        // Add v to current clique R
+        R.push_back(v);
+        // Compute new sets Pn and Xn for recursion
+        vector<int> Pn, Xn;
+        for (int w : P)
+            if (adj.hasEdge(v, w))
+                Pn.push_back(w);
+        for (int w : X)
+            if (adj.hasEdge(v, w))
+                Xn.push_back(w);
+        // Recursive call with updated sets
+        bronKerbosch(adj, R, Pn, Xn, count, best);
+        // Remove v from current clique R
+        R.pop_back();
+        // Move v from P to X
+        P.erase(find(P.begin(), P.end(), v));
+        X.push_back(v);
+    }
+}
+
+// Count the number of maximal cliques in the graph using Bron–Kerbosch algorithm
+template <class G>
+long long algoCliques::countCliques(const G &g)
+{
+    // We will count MAXIMAL cliques via Bron–Kerbosch (common interpretation in assignments).
+    int n = g.vertexCount();
+    // R: current clique, P: candidates, X: excluded
+    vector<int> R, P(n), X;
+    // Fill P with all vertex indices
+    iota(P.begin(), P.end(), 0);
+    long long count = 0;
+    vector<int> dummy;
+    // Run Bron–Kerbosch algorithm
+    bronKerbosch(g, R, P, X, count, dummy);
+    // Return total count of maximal cliques
+    return count;
+}
+
+// Find the largest clique in the graph using Bron–Kerbosch algorithm
+template <class G>
+vector<int> algoCliques::maxClique(const G &g)
+{
+    int n = g.vertexCount();
+    // R: current clique, P: candidates, X: excluded
+    vector<int> R, P(n), X;
+    // Fill P with all vertex indices
+    iota(P.begin(), P.end(), 0);
+    long long count = 0;
+    vector<int> best;
+    // Run Bron–Kerbosch algorithm to find largest clique
+    bronKerbosch(g, R, P, X, count, best);
+    // Sort the clique vertices for consistent output
+    sort(best.begin(), best.end());
+    // Return the largest clique found
+    return best;
+}
@@ -1,12 +1,82 @@
 // ===== algoMST.h =====
 #pragma once
 #include <vector>
+#include "GraphTypes.h"
 using namespace std;
 class Graph;
 
+// How algoMST::mstWeight(const Graph&) builds the tree
+enum class MSTMethod
+{
+    Auto,    // Prim when the graph is dense enough (see preferPrim), Filter-Kruskal otherwise
+    Kruskal, // collect and sort the edges: O(E log E) time, O(E) extra memory
+    FilterKruskal, // Kruskal that sorts only the edges still joining two components
+    Prim,    // array-based Prim: O(V²) time, O(V) extra memory, no edge list
+    Boruvka  // parallel Borůvka: O(E log V / threads) time, O(V) extra memory, no edge list
+};
+
 class algoMST
 {
 public:
     // 1) MST total weight (for undirected, connected graph). If not connected, returns -1.
-    static long long mstWeight(const Graph &g);
-};
\ No newline at end of file
+    // Float weights are summed exactly and rounded to the nearest integer.
+    // threads is the budget of Boruvka (0 = one per hardware thread); the others use one.
+    static long long mstWeight(const Graph &g, MSTMethod how = MSTMethod::Auto, int threads = 0);
+
+    // Same on the subgraph induced by vertices (e.g. one component), without copying it
+    static long long mstWeight(const Graph &g, const vector<int> &vertices);
+
+    // Same on any graph representation exposing vertexCount()/directed()/neighbors().
+    // The sum type follows the weight type (long long for integers, double for float).
+    // filter selects Filter-Kruskal over plain Kruskal.
+    template <class G>
+    static WeightSum<typename G::weight_type> mstWeight(const G &g, bool filter = false);
+
+    // Whether O(V²) Prim beats sorting E edges: true from about V² / log2 E edges up
+    static bool preferPrim(int V, long long E);
+
+private:
+    // Array-based Prim. Matrix storages are read row by row, and both the key update and the
+    // minimum search are plain loops over arrays that the compiler vectorizes; other storages
+    // update the keys from their neighbor lists. Defined in algoMST.cpp for the storage types.
+    template <class G>
+    static WeightSum<typename G::weight_type> prim(const G &g);
+
+    // Parallel Borůvka. Every round the threads pick the lightest edge at each vertex, reduce
+    // them to the lightest edge leaving each component with an atomic min, and merge along those
+    // edges in a concurrent union-find; O(log V) rounds. Edges are ordered by (weight, lower end,
+    // higher end), so equal weights never close a cycle and the tree does not depend on threads.
+    template <class G>
+    static WeightSum<typename G::weight_type> boruvka(const G &g, int threads);
+
+    // Kruskal over an already collected edge list of an n-vertex graph
+    template <class W>
+    static WeightSum<W> kruskal(int n, vector<BasicEdge<W>> &edges);
+
+    // Filter-Kruskal over the same: partition the edges around a sampled pivot weight, run on
+    // the light part first, then drop the heavy edges whose ends are already joined before
+    // going on with the rest. Parts below a cutoff are sorted and scanned as in Kruskal.
+    template <class W>
+    static WeightSum<W> filterKruskal(int n, vector<BasicEdge<W>> &edges);
+};
+
+template <class G>
+WeightSum<typename G::weight_type> algoMST::mstWeight(const G &g, bool filter)
+{
+    using W = typename G::weight_type;
+    // Return -1 if graph is directed (MST only for undirected)
+    if (g.directed())
+        return -1; // define MST only for undirected here
+    int n = g.vertexCount();
+    // Collect all edges (only upper triangle for undirected), keeping the compact weight type
+    vector<BasicEdge<W>> edges;
+    edges.reserve(n);
+    for (int i = 0; i < n; ++i)
+    {
+        auto r = g.neighbors(i);
+        for (auto it = r.begin(); it != r.end(); ++it)
+            if (*it > i)
+                edges.push_back({i, *it, it.weight()});
+    }
+    return filter ? filterKruskal<W>(n, edges) : kruskal<W>(n, edges);
+}
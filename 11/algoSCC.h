@@ -1,6 +1,7 @@
 // ===== Algorithms.h =====
 #pragma once
 #include <vector>
+#include "graphCSR.h"
 using namespace std;
 class Graph;
 
@@ -12,10 +13,119 @@ public:
     // For undirected graphs, this is equivalent to connected components.
     static vector<int> scc(const Graph &g);
 
+    // Same on the subgraph induced by vertices: comp[i] is the component of vertices[i]
+    // (vertices must not repeat)
+    static vector<int> scc(const Graph &g, const vector<int> &vertices);
+
+    // Same on any graph representation exposing vertexCount()/directed()/neighbors()
+    template <class G>
+    static vector<int> scc(const G &g);
+
 private:
 
-    // SCC helpers (Kosaraju)
-    static void dfs1(const vector<vector<int>> &m, int u, vector<int> &vis, vector<int> &order);
-    static void dfs2(const vector<vector<int>> &tr, int u, int cid, vector<int> &comp);
+    // SCC helpers (Kosaraju), iterative so long paths cannot overflow the call stack
+    template <class G>
+    static void dfs1(const G &g, int s, vector<int> &vis, vector<int> &order);
+    template <class G>
+    static void dfs2(const G &tr, int s, int cid, vector<int> &comp);
+
+};
+
+// First DFS to compute finishing order
+template <class G>
+void algoSCC::dfs1(const G &g, int s, vector<int> &vis, vector<int> &order)
+{
+    using It = decltype(g.neighbors(s).begin());
+    struct Frame { int u; It it, end; };
+    vector<Frame> st;
+    // Mark start node as visited
+    vis[s] = 1;
+    auto r = g.neighbors(s);
+    st.push_back({s, r.begin(), r.end()});
+    while (!st.empty())
+    {
+        Frame &f = st.back();
+        if (f.it != f.end)
+        {
+            // Visit the next neighbor of the top node
+            int v = *f.it;
+            ++f.it;
+            if (!vis[v])
+            {
+                vis[v] = 1;
+                auto rv = g.neighbors(v);
+                st.push_back({v, rv.begin(), rv.end()});
+            }
+        }
+        else
+        {
+            // Add node to order after visiting all neighbors
+            order.push_back(f.u);
+            st.pop_back();
+        }
+    }
+}
+
+// Second DFS to assign components in transposed graph
+template <class G>
+void algoSCC::dfs2(const G &tr, int s, int cid, vector<int> &comp)
+{
+    using It = decltype(tr.neighbors(s).begin());
+    struct Frame { It it, end; };
+    vector<Frame> st;
+    // Assign component id to start node
+    comp[s] = cid;
+    auto r = tr.neighbors(s);
+    st.push_back({r.begin(), r.end()});
+    while (!st.empty())
+    {
+        Frame &f = st.back();
+        if (!(f.it != f.end))
+        {
+            st.pop_back();
+            continue;
+        }
+        int v = *f.it;
+        ++f.it;
+        if (comp[v] == -1)
+        {
+            comp[v] = cid;
+            auto rv = tr.neighbors(v);
+            st.push_back({rv.begin(), rv.end()});
+        }
+    }
+}
 
-};
\ No newline at end of file
+// Kosaraju's algorithm to find strongly connected components
+template <class G>
+vector<int> algoSCC::scc(const G &g)
+{
+    int n = g.vertexCount();
+    vector<int> vis(n, 0), order;
+    order.reserve(n);
+    // Run first DFS to get finishing order
+    for (int i = 0; i < n; ++i)
+        if (!vis[i])
+            dfs1(g, i, vis, order);
+    // Initialize component ids
+    vector<int> comp(n, -1);
+    int cid = 0;
+    // If undirected the graph is its own transpose; otherwise build the transposed CSR
+    using Tr = CSRGraph<typename G::weight_type>;
+    Tr tr = g.directed() ? Tr::from(g, true) : Tr();
+    // Run second DFS in reverse finishing order to assign components
+    for (int i = n - 1; i >= 0; --i)
+    {
+        int v = order[i];
+        if (comp[v] == -1)
+        {
+            if (g.directed())
+                dfs2(tr, v, cid, comp);
+            else
+                dfs2(g, v, cid, comp);
+            cid++;
+        }
+    }
+    // Return component ids for each node
+    return comp; // components are 0..cid-1
+}
@@ -0,0 +1,137 @@
+// ===== algoStream.h =====
+#pragma once
+#include <vector>
+#include <numeric>
+#include <cstdint>
+#include "GraphTypes.h"
+#include "UnionFind.h"
+using namespace std;
+
+// Algorithms that only read the edges of an undirected graph as a stream, one pass or a few,
+// with O(V) memory: the source is any type exposing vertexCount() and forEachEdge(f) that calls
+// f(const Edge&) for every edge once (e.g. ImplicitGraph, which never stores its edges).
+class algoStream
+{
+public:
+    // Number of vertices with odd degree (one pass, one bit per vertex)
+    template <class S>
+    static int oddDegreeCount(const S &s);
+
+    // Number of connected components, isolated vertices included (one pass, union-find)
+    template <class S>
+    static int components(const S &s);
+
+    // Whether every degree is even and all edges lie in one component (one pass)
+    template <class S>
+    static bool hasEulerCircuit(const S &s);
+
+    // MST total weight, or -1 if not connected (found in one pass). Borůvka: every pass keeps the
+    // lightest edge leaving each component and merges along them, so O(log V) passes, O(V) memory.
+    template <class S>
+    static long long mstWeight(const S &s);
+};
+
+template <class S>
+int algoStream::oddDegreeCount(const S &s)
+{
+    vector<bool> odd(s.vertexCount(), false);
+    s.forEachEdge([&](const Edge &e) {
+        odd[e.u] = !odd[e.u];
+        odd[e.v] = !odd[e.v];
+    });
+    int count = 0;
+    for (bool b : odd)
+        count += b;
+    return count;
+}
+
+template <class S>
+int algoStream::components(const S &s)
+{
+    UnionFind c(s.vertexCount());
+    s.forEachEdge([&](const Edge &e) { c.unite(e.u, e.v); });
+    return c.count();
+}
+
+template <class S>
+bool algoStream::hasEulerCircuit(const S &s)
+{
+    int n = s.vertexCount();
+    UnionFind c(n);
+    vector<bool> odd(n, false), touched(n, false);
+    s.forEachEdge([&](const Edge &e) {
+        odd[e.u] = !odd[e.u];
+        odd[e.v] = !odd[e.v];
+        touched[e.u] = touched[e.v] = true;
+        c.unite(e.u, e.v);
+    });
+    // One component holding every vertex with edges (no edges: trivial circuit)
+    int root = -1;
+    for (int v = 0; v < n; ++v)
+    {
+        if (odd[v])
+            return false;
+        if (!touched[v])
+            continue;
+        if (root == -1)
+            root = c.find(v);
+        else if (c.find(v) != root)
+            return false;
+    }
+    return true;
+}
+
+template <class S>
+long long algoStream::mstWeight(const S &s)
+{
+    int n = s.vertexCount();
+    if (n <= 1)
+        return 0;
+    // One union-find pass settles disconnected graphs, which would otherwise take Borůvka
+    // passes until the components stop merging
+    if (components(s) > 1)
+        return -1;
+    UnionFind c(n);
+    long long total = 0;
+    // Lightest edge leaving each component; ties go to the lower edge index so that equal
+    // weights can never close a cycle. One record per component: one cache miss per update.
+    struct Best
+    {
+        long long index;
+        int w, u, v;
+    };
+    const long long NONE = -1;
+    vector<Best> best(n);
+    vector<int> label(n); // component root of every vertex, fixed during a pass
+    iota(label.begin(), label.end(), 0);
+    for (;;)
+    {
+        for (Best &b : best)
+            b.index = NONE;
+        long long index = 0;
+        s.forEachEdge([&](const Edge &e) {
+            int a = label[e.u], b = label[e.v];
+            if (a != b)
+                for (int r : {a, b})
+                {
+                    Best &x = best[r];
+                    if (x.index == NONE || e.w < x.w || (e.w == x.w && index < x.index))
+                        x = {index, e.w, e.u, e.v};
+                }
+            ++index;
+        });
+        bool merged = false;
+        for (int r = 0; r < n; ++r)
+            if (best[r].index != NONE && c.unite(best[r].u, best[r].v))
+            {
+                total += best[r].w;
+                merged = true;
+            }
+        if (c.count() == 1)
+            return total;
+        if (!merged)
+            return -1; // no edge joins the remaining components (cannot happen once connected)
+        for (int v = 0; v < n; ++v)
+            label[v] = c.find(v);
+    }
+}
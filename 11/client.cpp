@@ -25,7 +25,11 @@ enum { ALL_SET = V_SET | E_SET | S_SET };
 static void usage(const char* prog) {
     std::cerr << "Usage: " << prog
               << " [-h <host=127.0.0.1>] [-p <port=8080>] -v <vertices> -e <edges> -s <seed>\n"
-              << "Example: " << prog << " -h 127.0.0.1 -p 8080 -v 6 -e 8 -s 1234\n";
+              << "       " << prog << " [-h <host=127.0.0.1>] [-p <port=8080>] -f <graph.bin>\n"
+              << "       " << prog << " [-h ..] [-p ..] -g <gnm|rmat|ba|clique|grid> -v <vertices> -e <edges> -s <seed> [-o \"k=<clique> w=<max weight>\"]\n"
+              << "       " << prog << " [-h ..] [-p ..] -i -v <vertices> -e <edges> -s <seed>   (implicit: never stored, LF server)\n"
+              << "Example: " << prog << " -h 127.0.0.1 -p 8080 -v 6 -e 8 -s 1234\n"
+              << "The -f path is opened by the server, so it must be valid on the server's machine.\n";
     std::exit(1);
 }
 
@@ -40,16 +44,26 @@ int main(int argc, char* argv[]) {
     string A;
     // string for request to server
     string req;
+    // binary graph file for the server to load (-f)
+    string file;
+    // benchmark graph family (-g) and its options (-o)
+    string family, familyOpts;
+    // ask for the streaming answer over an implicit graph (-i)
+    bool implicitGraph = false;
 
     // Parse command-line arguments
     int opt;
-    while ((opt = getopt(argc, argv, "h:p:v:e:s:a:")) != -1) {
+    while ((opt = getopt(argc, argv, "h:p:v:e:s:a:f:g:o:i")) != -1) {
         switch (opt) {
             case 'h': host = optarg; break;
             case 'p': port = std::atoi(optarg); break;
             case 'v': V = std::atoi(optarg); mask |= V_SET; break;
             case 'e': E = std::atoi(optarg); mask |= E_SET; break;
             case 's': S = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 10)); mask |= S_SET; break;
+            case 'f': file = optarg; break;
+            case 'g': family = optarg; break;
+            case 'o': familyOpts = optarg; break;
+            case 'i': implicitGraph = true; break;
             //case 'a': A = optarg; break;
             default: usage(argv[0]);
         }
@@ -57,13 +71,26 @@ int main(int argc, char* argv[]) {
 
     // If some but not all required arguments are set, show usage
     if(mask != 0 && mask != ALL_SET) usage(argv[0]);
+    // A graph file replaces the random graph arguments
+    if(!file.empty() && mask != 0) usage(argv[0]);
+    // A graph family needs the size and seed
+    if(!family.empty() && mask != ALL_SET) usage(argv[0]);
+    if(implicitGraph && (mask != ALL_SET || !family.empty())) usage(argv[0]);
 
     // If all required arguments are set, build request string
     if(mask == ALL_SET) req = std::to_string(V) + " " + std::to_string(E) + " " + std::to_string(S) +
     " " + A + "\n";
 
+    // Ask for a benchmark graph family instead of a uniform random graph
+    if(!family.empty()) req = "GEN " + family + " " + std::to_string(V) + " " + std::to_string(E) + " " +
+    std::to_string(S) + " " + familyOpts + "\n";
+
+    // Ask for the seed-defined implicit graph (weights with -o "w=<max>")
+    if(implicitGraph) req = "STREAM " + std::to_string(V) + " " + std::to_string(E) + " " + std::to_string(S) +
+    " " + familyOpts + "\n";
+
     // If no arguments are set, use auto mode
-    if(mask == 0) req = "auto\n";
+    if(mask == 0) req = file.empty() ? "auto\n" : "LOAD " + file + "\n";
 
     // Create a TCP socket
     int sockfd = ::socket(AF_INET, SOCK_STREAM, 0);
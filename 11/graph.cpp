@@ -1,12 +1,345 @@
 #include "graph.h"
 #include <iostream>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <cstdio>
 using namespace std;
 
-Graph::Graph(int V, bool isDirected) : V(V), adjMatrix(V, vector<int>(V, 0)), isDirected(isDirected) {}
+// Bytes per weight cell of each WeightType
+static size_t cellBytes(WeightType t) {
+    switch (t) {
+        case WeightType::U8:  return 1;
+        case WeightType::U16: return 2;
+        default:              return 4;
+    }
+}
+
+// Build an empty storage of kind M with the given cell type
+template <template <class> class M>
+static GraphStorageVariant makeTyped(int V, bool isDirected, WeightType t) {
+    switch (t) {
+        case WeightType::U8:  return M<uint8_t>(V, isDirected);
+        case WeightType::U16: return M<uint16_t>(V, isDirected);
+        case WeightType::F32: return M<float>(V, isDirected);
+        default:              return M<int32_t>(V, isDirected);
+    }
+}
+
+// Build the selected storage for V vertices
+static GraphStorageVariant makeStorage(int V, bool isDirected, GraphStorage storage, WeightType weights) {
+    if (storage == GraphStorage::Bits)
+        return BitMatrix(V, isDirected);
+    if (storage == GraphStorage::Lists)
+        return makeTyped<AdjacencyLists>(V, isDirected, weights);
+    if (storage == GraphStorage::Triangular && !isDirected)
+        return makeTyped<TriangularMatrix>(V, isDirected, weights);
+    if (storage == GraphStorage::CSR)
+        return makeTyped<CSRGraph>(V, isDirected, weights);
+    if (storage == GraphStorage::Compressed)
+        return makeTyped<CompressedGraph>(V, isDirected, weights);
+    return makeTyped<DenseMatrix>(V, isDirected, weights);
+}
+
+// Copy every edge of src into a new storage of type Dst
+template <class Dst, class Src>
+static Dst copyStorage(const Src& src) {
+    Dst dst(src.vertexCount(), src.directed());
+    for (int u = 0; u < src.vertexCount(); ++u) {
+        auto r = src.neighbors(u);
+        for (auto it = r.begin(); it != r.end(); ++it) {
+            int v = *it;
+            if (!src.directed() && v < u)
+                continue; // undirected edges are written both ways by addEdge
+            if constexpr (is_same<Dst, BitMatrix>::value)
+                dst.addEdge(u, v);
+            else
+                dst.addEdge(u, v, static_cast<typename Dst::weight_type>(it.weight()));
+        }
+    }
+    return dst;
+}
+
+// Copy src into a storage of kind M with the given cell type
+template <template <class> class M, class Src>
+static GraphStorageVariant copyTyped(const Src& src, WeightType t) {
+    switch (t) {
+        case WeightType::U8:  return copyStorage<M<uint8_t>>(src);
+        case WeightType::U16: return copyStorage<M<uint16_t>>(src);
+        case WeightType::F32: return copyStorage<M<float>>(src);
+        default:              return copyStorage<M<int32_t>>(src);
+    }
+}
+
+// CSR snapshot of src with the given cell type
+template <class Src>
+static GraphStorageVariant freezeTyped(const Src& src, WeightType t) {
+    switch (t) {
+        case WeightType::U8:  return CSRGraph<uint8_t>::from(src);
+        case WeightType::U16: return CSRGraph<uint16_t>::from(src);
+        case WeightType::F32: return CSRGraph<float>::from(src);
+        default:              return CSRGraph<int32_t>::from(src);
+    }
+}
+
+// Compressed copy of src with the given cell type
+template <class Src>
+static GraphStorageVariant compressTyped(const Src& src, WeightType t) {
+    switch (t) {
+        case WeightType::U8:  return CompressedGraph<uint8_t>::from(src);
+        case WeightType::U16: return CompressedGraph<uint16_t>::from(src);
+        case WeightType::F32: return CompressedGraph<float>::from(src);
+        default:              return CompressedGraph<int32_t>::from(src);
+    }
+}
+
+// Check if weight is stored exactly by cell type W
+template <class W>
+static bool fits(double weight) {
+    if (is_floating_point<W>::value)
+        return true;
+    return weight == floor(weight) && weight >= (double)numeric_limits<W>::min() &&
+           weight <= (double)numeric_limits<W>::max();
+}
+
+// Replace a storage of kind M by a wider one until weight fits
+template <template <class> class M>
+static void widen(GraphStorageVariant& adj, double weight) {
+    if (auto* m = get_if<M<uint8_t>>(&adj)) {
+        if (fits<uint8_t>(weight)) return;
+        adj = M<uint16_t>(*m);
+    }
+    if (auto* m = get_if<M<uint16_t>>(&adj)) {
+        if (fits<uint16_t>(weight)) return;
+        adj = M<int32_t>(*m);
+    }
+    if (auto* m = get_if<M<int32_t>>(&adj)) {
+        if (fits<int32_t>(weight)) return;
+        adj = M<float>(*m);
+    }
+}
+
+// Estimated bytes of a matrix storage (weighted undirected matrices keep only the upper triangle)
+static double matrixBytes(int V, bool weighted, WeightType t, bool isDirected) {
+    double cells = (double)V * V;
+    if (!weighted)
+        return cells / 8;
+    return (isDirected ? cells : cells / 2) * cellBytes(t);
+}
+
+// Weighted matrix storage for the direction
+static GraphStorage weightedMatrix(bool isDirected) {
+    return isDirected ? GraphStorage::Matrix : GraphStorage::Triangular;
+}
+
+// Estimated bytes of adjacency lists: id + weight per entry, two vectors per vertex
+static double listBytes(int V, long long E, bool isDirected, WeightType t) {
+    double entries = (double)E * (isDirected ? 1 : 2);
+    return entries * (sizeof(int) + cellBytes(t)) + 2.0 * sizeof(vector<int>) * V;
+}
+
+// splitmix64 finalizer
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Hash of one edge; undirected edges are hashed with the smaller endpoint first. An integral
+// weight is hashed as its exact integer value, so it hashes alike in every cell type; only a
+// fractional one (which only float cells hold) is hashed by its float bits.
+static void edgeHash(int u, int v, double w, bool directed, uint64_t& a, uint64_t& b) {
+    if (!directed && v < u)
+        swap(u, v);
+    uint64_t key;
+    if (w == floor(w) && fabs(w) < 9.2e18) {
+        key = (uint64_t)(int64_t)w;
+    } else {
+        float f = (float)w;
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        key = mix(bits + 0x6a09e667f3bcc909ULL);
+    }
+    uint64_t x = mix(((uint64_t)(uint32_t)u << 32 | (uint32_t)v) + 0x9e3779b97f4a7c15ULL * (key + 1));
+    a = mix(x ^ 0x243f6a8885a308d3ULL);
+    b = mix(x ^ 0x13198a2e03707344ULL);
+}
+
+void GraphFingerprint::add(int u, int v, double w, bool directed) {
+    uint64_t a, b;
+    edgeHash(u, v, w, directed, a, b);
+    lo += a;
+    hi += b;
+}
+
+void GraphFingerprint::remove(int u, int v, double w, bool directed) {
+    uint64_t a, b;
+    edgeHash(u, v, w, directed, a, b);
+    lo -= a;
+    hi -= b;
+}
+
+string GraphFingerprint::str() const {
+    char buf[33];
+    snprintf(buf, sizeof(buf), "%016llx%016llx", (unsigned long long)hi, (unsigned long long)lo);
+    return buf;
+}
+
+Graph::Graph(int V, bool isDirected, GraphStorage storage, WeightType weights)
+    : V(V), isDirected(isDirected),
+      adj(makeStorage(V, isDirected, storage == GraphStorage::Auto ? chooseStorage(V, 0, isDirected, false, weights) : storage, weights)),
+      cells(weights), adaptive(storage == GraphStorage::Auto), edges(0), weightedEdges(0),
+      deg(V, 0), wdeg(V, 0.0), oddCount(0) {}
+
+// Wrap a built storage; an empty wdeg / negative weightedEdges are computed from the edges,
+// together with the edge hash
+Graph::Graph(GraphStorageVariant built, vector<double> wdeg, long long weightedEdges, GraphFingerprint hash)
+    : V(0), isDirected(false), adj(std::move(built)), cells(WeightType::I32), adaptive(true), edges(0),
+      weightedEdges(weightedEdges), hash(hash), wdeg(std::move(wdeg)), oddCount(0) {
+    visit([&](const auto& m) {
+        V = m.vertexCount();
+        isDirected = m.directed();
+        deg.resize(V);
+        for (int u = 0; u < V; ++u) {
+            deg[u] = m.degree(u);
+            edges += deg[u];
+            oddCount += deg[u] & 1;
+        }
+        if (this->wdeg.empty() || this->weightedEdges < 0) {
+            this->wdeg.assign(V, 0.0);
+            this->weightedEdges = 0;
+            this->hash = {};
+            for (int u = 0; u < V; ++u) {
+                auto r = m.neighbors(u);
+                for (auto it = r.begin(); it != r.end(); ++it) {
+                    this->wdeg[u] += it.weight();
+                    if (!isDirected && *it < u)
+                        continue;
+                    this->weightedEdges += it.weight() != 1;
+                    this->hash.add(u, *it, it.weight(), isDirected);
+                }
+            }
+        }
+    });
+    if (!isDirected)
+        edges /= 2; // every undirected edge sits in two rows
+    if (storage() != GraphStorage::Bits) // bits keep the I32 default
+        cells = weightType();
+}
+
+// Adaptive graph sized for about E edges
+Graph Graph::forEdges(int V, long long E, bool isDirected, bool weighted, WeightType weights) {
+    Graph g(V, isDirected, chooseStorage(V, E, isDirected, weighted, weights), weights);
+    g.adaptive = true;
+    return g;
+}
+
+// Pick the storage with the smallest memory estimate
+GraphStorage Graph::chooseStorage(int V, long long E, bool isDirected, bool weighted, WeightType weights) {
+    if (listBytes(V, E, isDirected, weights) < matrixBytes(V, weighted, weights, isDirected))
+        return GraphStorage::Lists;
+    return weighted ? weightedMatrix(isDirected) : GraphStorage::Bits;
+}
+
+// Convert the storage if the edge density crossed the threshold
+void Graph::adapt(bool growing) {
+    if (!adaptive)
+        return;
+    GraphStorage cur = storage();
+    if (growing && cur == GraphStorage::Lists) {
+        // Lists grew past the size of a matrix
+        if (chooseStorage(V, edges, isDirected, weightedEdges > 0, weightType()) != cur)
+            convertTo(GraphStorage::Auto);
+    } else if (!growing && cur != GraphStorage::Lists) {
+        // Matrix shrank well below the threshold (factor 2 keeps add/remove at the boundary from thrashing)
+        bool weighted = cur != GraphStorage::Bits;
+        if (2 * listBytes(V, edges, isDirected, weightType()) < matrixBytes(V, weighted, weightType(), isDirected))
+            convertTo(GraphStorage::Lists);
+    }
+}
+
+// Move every edge into the given storage
+void Graph::convertTo(GraphStorage target) {
+    GraphStorage cur = storage();
+    bool weighted = weightedEdges > 0;
+    // Bits keep no weight type of their own, so go back to the preferred one
+    WeightType t = cur == GraphStorage::Bits ? cells : weightType();
+    if (target == GraphStorage::Auto)
+        target = chooseStorage(V, edges, isDirected, weighted, t);
+    if (target == cur)
+        return;
+    if (target == GraphStorage::Bits && weighted) {
+        cerr << "Error: Bit storage holds only unweighted edges (weight 1)." << endl;
+        return;
+    }
+    if (target == GraphStorage::Triangular && isDirected) {
+        cerr << "Error: Triangular storage holds only undirected graphs." << endl;
+        return;
+    }
+    adj = visit([&](const auto& m) -> GraphStorageVariant {
+        if (target == GraphStorage::CSR)
+            return freezeTyped(m, t);
+        if (target == GraphStorage::Compressed)
+            return compressTyped(m, t);
+        if (target == GraphStorage::Bits)
+            return copyStorage<BitMatrix>(m);
+        if (target == GraphStorage::Lists)
+            return copyTyped<AdjacencyLists>(m, t);
+        if (target == GraphStorage::Triangular)
+            return copyTyped<TriangularMatrix>(m, t);
+        return copyTyped<DenseMatrix>(m, t);
+    });
+}
+
+// Switch to a cell type able to hold weight
+void Graph::widenFor(double weight) {
+    widen<DenseMatrix>(adj, weight);
+    widen<TriangularMatrix>(adj, weight);
+    widen<AdjacencyLists>(adj, weight);
+}
+
+// Move out of read-only storage into the storage that suits about E edges
+void Graph::thaw(long long E, bool weighted) {
+    GraphStorage cur = storage();
+    if (cur == GraphStorage::CSR || cur == GraphStorage::Compressed)
+        convertTo(chooseStorage(V, E, isDirected, weighted, weightType()));
+}
+
+// Change the degree of x by d, keeping oddCount in step
+void Graph::bumpDegree(int x, int d) {
+    bool wasOdd = deg[x] & 1;
+    deg[x] += d;
+    if (wasOdd != (bool)(deg[x] & 1))
+        oddCount += wasOdd ? -1 : 1;
+}
+
+// Update edge count and degrees for edge u -> v changing weight from old to now
+void Graph::bookEdge(int u, int v, double old, double now) {
+    int d = (old == 0) - (now == 0); // +1 new edge, -1 removed edge, 0 weight change
+    edges += d;
+    weightedEdges += (now != 0 && now != 1) - (old != 0 && old != 1);
+    if (old != 0)
+        hash.remove(u, v, old, isDirected);
+    if (now != 0)
+        hash.add(u, v, now, isDirected);
+    bumpDegree(u, d);
+    wdeg[u] += now - old;
+    if (!isDirected) {
+        bumpDegree(v, d);
+        wdeg[v] += now - old;
+    }
+}
 
 // Add edge between u and v
-// If the graph is undirected, also add the edge from v to u
 bool Graph::addEdge(int u, int v, int weight) {
+    return addEdge(u, v, (double)weight);
+}
+
+// Add edge between u and v
+// If the graph is undirected, also add the edge from v to u
+bool Graph::addEdge(int u, int v, double weight) {
     if (u < 0 || u >= V || v < 0 || v >= V) {
         cerr << "Error: Vertex index out of bounds." << endl;
         return false;
@@ -15,17 +348,93 @@ bool Graph::addEdge(int u, int v, int weight) {
         cerr << "Error: Cannot add an edge from a vertex to itself." << endl;
         return false;
     }
-    if (adjMatrix[u][v] == weight) {
+    // Weight 0 means "no edge" in every storage; a stored 0 (or NaN) would count as missing.
+    // Negative weights are kept (they widen the cells to int32 or float).
+    if (!(weight < 0 || weight > 0)) {
+        cerr << "Error: Edge weight must not be 0." << endl;
+        return false;
+    }
+    double old = this->weight(u, v);
+    if (old == weight) {
         cerr << "Error: Edge already exists between " << u << " and " << v << "." << endl;
         return false;
     }
-    // If the edge already exists, update its weight
-    adjMatrix[u][v] = weight;
-    if (!isDirected)
-        adjMatrix[v][u] = weight; // if undirected graph
-
+    if (!insert(u, v, weight, old)) {
+        cerr << "Error: Bit storage holds only unweighted edges (weight 1)." << endl;
+        return false;
+    }
     return true;
+}
 
+// Add a batch of edges without writing diagnostics
+BulkInsertResult Graph::addEdges(const Edge* first, size_t count, EdgeCheck check, size_t limit) {
+    BulkInsertResult res;
+    for (size_t i = 0; i < count && res.added < limit; ++i) {
+        const Edge& e = first[i];
+        if (check != EdgeCheck::Trusted) {
+            if (e.u < 0 || e.u >= V || e.v < 0 || e.v >= V) {
+                res.outOfRange++;
+                continue;
+            }
+            if (e.u == e.v) {
+                res.selfLoops++;
+                continue;
+            }
+        }
+        if (!(e.w < 0 || e.w > 0)) {
+            res.rejected++;
+            continue;
+        }
+        double old = weight(e.u, e.v);
+        if (old == e.w) {
+            res.duplicates++;
+            continue;
+        }
+        if (!insert(e.u, e.v, e.w, old)) {
+            res.rejected++;
+            continue;
+        }
+        res.added++;
+    }
+    res.skipped = res.outOfRange + res.selfLoops + res.duplicates + res.rejected;
+    // Only ReportCount promises the per-reason breakdown
+    if (check != EdgeCheck::ReportCount)
+        res.outOfRange = res.selfLoops = res.duplicates = res.rejected = 0;
+    return res;
+}
+
+// Store edge u-v with the given weight, whose current weight is old.
+// Returns false if the storage cannot hold the weight (fixed bit storage and weight != 1).
+bool Graph::insert(int u, int v, double weight, double old) {
+    thaw(edges + (old == 0), weightedEdges > 0 || weight != 1);
+    if (auto* bits = get_if<BitMatrix>(&adj)) {
+        if (weight == 1) {
+            bits->addEdge(u, v);
+            bookEdge(u, v, old, weight);
+            return true;
+        }
+        if (!adaptive)
+            return false;
+        // An adaptive graph moves to a weighted storage
+        convertTo(listBytes(V, edges + 1, isDirected, cells) < matrixBytes(V, true, cells, isDirected)
+                      ? GraphStorage::Lists
+                      : weightedMatrix(isDirected));
+    }
+    // If the edge already exists, update its weight
+    widenFor(weight);
+    // Book the weight as stored (float cells round integers above 2^24), so the hash and the
+    // weighted degrees match a graph rebuilt from this storage
+    std::visit([&](auto& m) {
+        using M = decay_t<decltype(m)>;
+        if constexpr (!is_same<M, BitMatrix>::value && !IsFrozen<M>::value) {
+            m.addEdge(u, v, static_cast<typename M::weight_type>(weight));
+            weight = static_cast<typename M::weight_type>(weight);
+        }
+    }, adj);
+    bookEdge(u, v, old, weight);
+    if (old == 0)
+        adapt(true);
+    return true;
 }
 
 // Remove edge between u and v
@@ -34,14 +443,18 @@ void Graph::removeEdge(int u, int v) {
         cerr << "Error: Vertex index out of bounds." << endl;
         return;
     }
-    if (adjMatrix[u][v] == 0) {
+    if (!hasEdge(u, v)) {
         cerr << "Error: No edge exists between " << u << " and " << v << "." << endl;
         return;
     }
-    adjMatrix[u][v] = 0;
-    if (!isDirected)
-        adjMatrix[v][u] = 0; // if undirected graph
-  
+    double old = weight(u, v);
+    thaw(edges - 1, weightedEdges > 0);
+    std::visit([&](auto& m) {
+        if constexpr (!IsFrozen<decay_t<decltype(m)>>::value)
+            m.removeEdge(u, v);
+    }, adj);
+    bookEdge(u, v, old, 0);
+    adapt(false);
 }
 
 // Print the adjacency matrix of the graph
@@ -50,18 +463,73 @@ void Graph::printGraph() {
     for (int i = 0; i < V; i++) {
         cout << i << ": ";
         for (int j = 0; j < V; j++) {
-            cout << adjMatrix[i][j] << " ";
+            cout << weight(i, j) << " ";
         }
         cout << endl;
     }
 }
 
-// Get the degree of a vertex
-int Graph::degree(int u) {
-    int deg = 0;
-    for (int j = 0; j < V; j++) {
-        if (adjMatrix[u][j] != 0) // if there is an edge between u and j with non-zero weight
-            deg++;
-    }
-    return deg;
+// Kind of each storage type
+template <class W>
+static GraphStorage kindOf(const DenseMatrix<W>&) { return GraphStorage::Matrix; }
+template <class W>
+static GraphStorage kindOf(const TriangularMatrix<W>&) { return GraphStorage::Triangular; }
+static GraphStorage kindOf(const BitMatrix&) { return GraphStorage::Bits; }
+template <class W>
+static GraphStorage kindOf(const AdjacencyLists<W>&) { return GraphStorage::Lists; }
+template <class W>
+static GraphStorage kindOf(const CSRGraph<W>&) { return GraphStorage::CSR; }
+template <class W>
+static GraphStorage kindOf(const CompressedGraph<W>&) { return GraphStorage::Compressed; }
+
+// Memory placement of each storage type (only the matrices have their own buffer)
+template <class M>
+static MemoryPlacement placementOf(const M&) { return {}; }
+template <class W>
+static MemoryPlacement placementOf(const DenseMatrix<W>& m) { return m.placement(); }
+template <class W>
+static MemoryPlacement placementOf(const TriangularMatrix<W>& m) { return m.placement(); }
+static MemoryPlacement placementOf(const BitMatrix& m) { return m.placement(); }
+
+MemoryPlacement Graph::placement() const {
+    return visit([](const auto& m) { return placementOf(m); });
+}
+
+size_t Graph::byteCount() const {
+    return visit([](const auto& m) { return m.byteCount(); }) + deg.size() * sizeof(int) + wdeg.size() * sizeof(double);
+}
+
+// Edge hash with the vertex count and direction folded in
+GraphFingerprint Graph::fingerprint() const {
+    GraphFingerprint f = hash;
+    uint64_t shape = mix(((uint64_t)V << 1 | isDirected) + 0x3c6ef372fe94f82bULL);
+    f.lo ^= shape;
+    f.hi ^= mix(shape);
+    return f;
+}
+
+// Which storage the graph currently uses
+GraphStorage Graph::storage() const {
+    return visit([](const auto& m) { return kindOf(m); });
+}
+
+// Cell type of the active storage
+WeightType Graph::weightType() const {
+    return visit([](const auto& m) {
+        using W = typename decay_t<decltype(m)>::weight_type;
+        if (is_same<W, uint16_t>::value) return WeightType::U16;
+        if (is_same<W, int32_t>::value)  return WeightType::I32;
+        if (is_same<W, float>::value)    return WeightType::F32;
+        return WeightType::U8;
+    });
+}
+
+// Check if there is an edge u -> v
+bool Graph::hasEdge(int u, int v) const {
+    return visit([u, v](const auto& m) { return m.hasEdge(u, v); });
+}
+
+// Weight of edge u -> v (0 if there is no edge)
+double Graph::weight(int u, int v) const {
+    return visit([u, v](const auto& m) { return (double)m.weight(u, v); });
 }
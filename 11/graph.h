@@ -1,33 +1,222 @@
 #pragma once
 #include <vector>
+#include <variant>
+#include <cstdint>
+#include <string>
+#include "GraphTypes.h"
+#include "graphDense.h"
+#include "graphTriangular.h"
+#include "graphBits.h"
+#include "graphLists.h"
+#include "graphCSR.h"
+#include "graphCompressed.h"
+#include "graphView.h"
 using namespace std;
 
+// How a Graph stores its edges
+enum class GraphStorage {
+    Matrix, // one weight cell per vertex pair
+    Triangular, // one weight cell per unordered pair (i < j), undirected graphs only; a directed
+                // graph asking for it gets Matrix
+    Bits,   // one bit per cell, unweighted graphs only (every edge has weight 1)
+    Lists,  // sorted adjacency lists, O(V+E) memory
+    CSR,    // read-only compressed rows (e.g. a mapped graph file); the first change converts it
+            // to the storage chooseStorage() picks
+    Compressed, // read-only gap/varint encoded rows, smallest for huge sparse graphs; changes
+                // convert it like CSR
+    Auto    // pick from the expected edge count and keep following the density (see Graph::forEdges)
+};
+
+// Cell type of Matrix and Lists storage. Smaller types save memory; a weight that does not
+// fit makes the storage widen itself (U8 -> U16 -> I32 -> F32).
+enum class WeightType { U8, U16, I32, F32 };
+
+// How much Graph::addEdges checks the edges it is given
+enum class EdgeCheck {
+    Trusted,     // caller guarantees valid endpoints and no self-loops; only duplicates are skipped
+    SkipInvalid, // out-of-range endpoints, self-loops and duplicates are skipped silently
+    ReportCount  // like SkipInvalid, and the result tells how many were skipped for each reason
+};
+
+// Outcome of Graph::addEdges
+struct BulkInsertResult {
+    size_t added = 0;      // edges inserted or re-weighted
+    size_t skipped = 0;    // edges not inserted
+    // Breakdown of skipped (filled only with EdgeCheck::ReportCount)
+    size_t outOfRange = 0; // endpoint outside 0..V-1
+    size_t selfLoops = 0;  // u == v
+    size_t duplicates = 0; // edge already present with the same weight
+    size_t rejected = 0;   // weight 0 or NaN, or not one the storage can hold (weight != 1 on fixed bit storage)
+};
+
+// 128-bit hash of a set of weighted edges that does not depend on the order they were added in:
+// the sum of one mixed hash per edge, so adding or removing an edge updates it in O(1).
+// Weights are hashed as the float they round to, so every cell type gives the same value.
+struct GraphFingerprint {
+    uint64_t lo = 0, hi = 0;
+
+    // Add / take out edge u -> v (u-v if undirected) with weight w
+    void add(int u, int v, double w, bool directed);
+    void remove(int u, int v, double w, bool directed);
+
+    bool operator==(const GraphFingerprint& o) const { return lo == o.lo && hi == o.hi; }
+    bool operator!=(const GraphFingerprint& o) const { return !(*this == o); }
+
+    // 32 hex digits
+    string str() const;
+};
+
+// Every storage a Graph can switch between
+using GraphStorageVariant = variant<DenseMatrix<uint8_t>, DenseMatrix<uint16_t>, DenseMatrix<int32_t>, DenseMatrix<float>,
+                                    TriangularMatrix<uint8_t>, TriangularMatrix<uint16_t>, TriangularMatrix<int32_t>,
+                                    TriangularMatrix<float>,
+                                    BitMatrix,
+                                    AdjacencyLists<uint8_t>, AdjacencyLists<uint16_t>, AdjacencyLists<int32_t>, AdjacencyLists<float>,
+                                    CSRGraph<uint8_t>, CSRGraph<uint16_t>, CSRGraph<int32_t>, CSRGraph<float>,
+                                    CompressedGraph<uint8_t>, CompressedGraph<uint16_t>, CompressedGraph<int32_t>,
+                                    CompressedGraph<float>>;
+
+// Graph with a run-time chosen storage. The typed storages (DenseMatrix<W>, TriangularMatrix<W>, BitMatrix,
+// AdjacencyLists<W>, CSRGraph<W>, CompressedGraph<W>) are what the algorithm templates run on; Graph hands the active one
+// out through visit().
 class Graph {
     int V; // number of vertices
-    vector<vector<int>> adjMatrix;
     bool isDirected;
+    GraphStorageVariant adj;
+    WeightType cells;   // preferred cell type when a weighted storage is built
+    bool adaptive;      // storage follows the edge density (GraphStorage::Auto)
+    long long edges;    // number of edges (an undirected edge counts once)
+    long long weightedEdges; // edges whose weight is not 1
+    GraphFingerprint hash;   // sum over the edges, kept in step by bookEdge()
+    vector<int> deg;       // degree of each vertex (out-degree if directed)
+    vector<double> wdeg;   // sum of the weights of each vertex's edges
+    int oddCount;          // number of vertices with odd degree
+
+    // Change the degree of x by d, keeping oddCount in step
+    void bumpDegree(int x, int d);
+
+    // Book an edge u -> v whose weight changes from old to now (0 = no edge)
+    void bookEdge(int u, int v, double old, double now);
+
+    // Switch to a cell type able to hold weight
+    void widenFor(double weight);
+
+    // Convert the storage if the density crossed the threshold (adaptive graphs only)
+    void adapt(bool growing);
+
+    // Store edge u-v whose current weight is old, with no checks and no diagnostics
+    bool insert(int u, int v, double weight, double old);
+
+    // Leave read-only storage (CSR, Compressed) before a change (the new edge count is about E)
+    void thaw(long long E, bool weighted);
+
+    // Wrap a built storage; wdeg, weightedEdges and the edge hash are computed from it unless given
+    Graph(GraphStorageVariant built, vector<double> wdeg, long long weightedEdges, GraphFingerprint hash = {});
+    friend class GraphFile;
 
 public:
-    Graph(int V, bool isDirected = false);
+    Graph(int V, bool isDirected = false, GraphStorage storage = GraphStorage::Matrix,
+          WeightType weights = WeightType::I32);
 
-    // Add edge between u and v
+    // Adaptive graph over an immutable CSR; no edge is copied until the graph is changed
+    template <class W>
+    explicit Graph(CSRGraph<W> csr) : Graph(GraphStorageVariant(std::move(csr)), {}, -1) {}
+
+    // Adaptive graph over an already filled bit matrix
+    explicit Graph(BitMatrix bits) : Graph(GraphStorageVariant(std::move(bits)), {}, -1) {}
+
+    // Adaptive graph sized for about E edges: starts with the storage chooseStorage() picks
+    // and converts later if the density moves across the threshold.
+    static Graph forEdges(int V, long long E, bool isDirected = false, bool weighted = false,
+                          WeightType weights = WeightType::I32);
+
+    // Storage that uses the least memory for V vertices and E edges: Lists when sparse, otherwise
+    // Bits for unweighted, Triangular for weighted undirected and Matrix for weighted directed graphs.
+    static GraphStorage chooseStorage(int V, long long E, bool isDirected, bool weighted,
+                                      WeightType weights = WeightType::I32);
+
+    // Add edge between u and v; the weight must not be 0 ("no edge"), negative weights are stored
     bool addEdge(int u, int v, int weight = 1);
 
+    // Add edge between u and v with a real weight (switches storage to float cells if needed)
+    bool addEdge(int u, int v, double weight);
+
+    // Add count edges starting at first, stopping once limit edges were added.
+    // Never writes to a stream; invalid edges are handled as check says.
+    BulkInsertResult addEdges(const Edge* first, size_t count, EdgeCheck check = EdgeCheck::SkipInvalid,
+                              size_t limit = SIZE_MAX);
+    BulkInsertResult addEdges(const vector<Edge>& list, EdgeCheck check = EdgeCheck::SkipInvalid,
+                              size_t limit = SIZE_MAX) {
+        return addEdges(list.data(), list.size(), check, limit);
+    }
+
     // Remove edge between u and v
     void removeEdge(int u, int v);
 
     // Print matrix
     void printGraph();
 
-    // Degree of a vertex
-    int degree(int u);
+    // Degree of a vertex, O(1)
+    int degree(int u) const { return deg[u]; }
+
+    // Sum of the weights of the edges of a vertex, O(1)
+    double weightedDegree(int u) const { return wdeg[u]; }
+
+    // Number of vertices with odd degree, O(1)
+    int oddDegreeCount() const { return oddCount; }
 
     // Get number of vertices
     int vertexCount() const { return V; }
 
-    // Get adjacency matrix
-    const vector<vector<int>>& getMatrix() const { return adjMatrix; }
+    // Number of edges
+    long long edgeCount() const { return edges; }
 
     // Check if the graph is directed
     bool directed() const { return isDirected; }
+
+    // Check if some edge has a weight other than 1
+    bool weighted() const { return weightedEdges > 0; }
+
+    // Identity of the graph for caches: equal for graphs with the same vertex count, direction
+    // and weighted edges, whatever their storage or insertion order. O(1), maintained by every change.
+    GraphFingerprint fingerprint() const;
+
+    // Which storage the graph currently uses (never Auto)
+    GraphStorage storage() const;
+
+    // Where the memory of the storage was placed: huge pages and NUMA policy of a matrix
+    // (see GraphMemory), "heap" for the row-based storages
+    MemoryPlacement placement() const;
+
+    // Bytes held by the storage and the per-vertex degree arrays, O(V) at most
+    size_t byteCount() const;
+
+    // Cell type of the storage (U8 for Bits)
+    WeightType weightType() const;
+
+    // Convert to the given storage (Auto re-runs chooseStorage() on the current edge count)
+    void convertTo(GraphStorage storage);
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const;
+
+    // Weight of edge u -> v (0 if there is no edge)
+    double weight(int u, int v) const;
+
+    // Call f with the active storage; algorithms run on it directly
+    template <class F>
+    auto visit(F &&f) const { return std::visit(std::forward<F>(f), adj); }
+
+    // Call f with a GraphView of the active storage induced by vertices (ids of this graph);
+    // vertex i of the view is the i-th smallest of them. No edge is copied.
+    template <class F>
+    auto visitInduced(const vector<int>& vertices, F &&f) const {
+        return visit([&](const auto& m) { return f(GraphView<decay_t<decltype(m)>>(m, vertices)); });
+    }
+
+    // Immutable CSR snapshot of the current edges, O(V+E) to traverse afterwards
+    template <class W = int>
+    CSRGraph<W> freeze() const {
+        return visit([](const auto& m) { return CSRGraph<W>::from(m); });
+    }
 };
@@ -0,0 +1,36 @@
+// ===== graphBits.cpp =====
+#include "graphBits.h"
+
+BitMatrix::BitMatrix(int V, bool isDirected)
+    : V(V), isDirected(isDirected), words(((size_t)V + 63) / 64), stride((words + 7) / 8 * 8),
+      bits((size_t)V * stride) {}
+
+// Set bit v of row u (and bit u of row v if undirected)
+void BitMatrix::addEdge(int u, int v) {
+    row(u)[v >> 6] |= 1ULL << (v & 63);
+    if (!isDirected)
+        row(v)[u >> 6] |= 1ULL << (u & 63);
+}
+
+// Set the same bits with atomic ORs, so concurrent writers to one word do not lose bits
+void BitMatrix::addEdgeAtomic(int u, int v) {
+    __atomic_fetch_or(&row(u)[v >> 6], 1ULL << (v & 63), __ATOMIC_RELAXED);
+    if (!isDirected)
+        __atomic_fetch_or(&row(v)[u >> 6], 1ULL << (u & 63), __ATOMIC_RELAXED);
+}
+
+// Clear bit v of row u (and bit u of row v if undirected)
+void BitMatrix::removeEdge(int u, int v) {
+    row(u)[v >> 6] &= ~(1ULL << (v & 63));
+    if (!isDirected)
+        row(v)[u >> 6] &= ~(1ULL << (u & 63));
+}
+
+// Count the set bits of row u
+int BitMatrix::degree(int u) const {
+    const uint64_t* r = row(u);
+    int deg = 0;
+    for (size_t w = 0; w < words; ++w)
+        deg += __builtin_popcountll(r[w]);
+    return deg;
+}
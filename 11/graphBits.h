@@ -0,0 +1,81 @@
+// ===== graphBits.h =====
+#pragma once
+#include <cstdint>
+#include "AlignedBuffer.h"
+#include "GraphTypes.h"
+using namespace std;
+
+// Adjacency matrix with one bit per cell, for unweighted graphs (every edge has weight 1).
+// Each row is padded to whole 64-byte cache lines so rows never share a line.
+class BitMatrix {
+    int V;                        // number of vertices
+    bool isDirected;
+    size_t words;                 // 64-bit words holding V bits
+    size_t stride;                // words per row including padding (multiple of 8)
+    AlignedBuffer<uint64_t> bits; // V rows of stride words
+
+    uint64_t* row(int u) { return bits.data() + (size_t)u * stride; }
+    const uint64_t* row(int u) const { return bits.data() + (size_t)u * stride; }
+
+public:
+    using weight_type = uint8_t;
+
+    // Walks the set bits of one row, lowest first
+    class NeighborIterator {
+        const uint64_t* r;
+        size_t w, n;   // current word, number of words
+        uint64_t cur;  // bits of word w not visited yet
+        // Move to the next word that still has a set bit
+        void settle() {
+            while (cur == 0 && w < n)
+                if (++w < n) cur = r[w];
+        }
+    public:
+        NeighborIterator(const uint64_t* r, size_t w, size_t n) : r(r), w(w), n(n), cur(w < n ? r[w] : 0) { settle(); }
+        int operator*() const { return (int)(w * 64 + __builtin_ctzll(cur)); }
+        uint8_t weight() const { return 1; }
+        NeighborIterator& operator++() { cur &= cur - 1; settle(); return *this; }
+        bool operator!=(const NeighborIterator& o) const { return w != o.w || cur != o.cur; }
+    };
+
+    BitMatrix(int V = 0, bool isDirected = false);
+
+    // Set the bit(s) of edge u-v (both directions if undirected)
+    void addEdge(int u, int v);
+
+    // Same as addEdge, safe to call from several threads at once
+    void addEdgeAtomic(int u, int v);
+
+    // Clear the bit(s) of edge u-v
+    void removeEdge(int u, int v);
+
+    // Degree of a vertex (popcount of its row)
+    int degree(int u) const;
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Check if the graph is directed
+    bool directed() const { return isDirected; }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return (row(u)[v >> 6] >> (v & 63)) & 1; }
+
+    // Weight of edge u -> v (1 if there is an edge, else 0)
+    uint8_t weight(int u, int v) const { return hasEdge(u, v) ? 1 : 0; }
+
+    // Neighbors of u in ascending order
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        return {NeighborIterator(row(u), 0, words), NeighborIterator(row(u), words, words)};
+    }
+
+    // Row u as raw words (words() of them are meaningful)
+    const uint64_t* rowBits(int u) const { return row(u); }
+
+    // Where the bits were placed (see GraphMemory)
+    const MemoryPlacement& placement() const { return bits.placement(); }
+    size_t rowWords() const { return words; }
+
+    // Bytes held by the bits, row padding included
+    size_t byteCount() const { return bits.size() * sizeof(uint64_t); }
+};
@@ -0,0 +1,227 @@
+// ===== graphCSR.h =====
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include "GraphTypes.h"
+using namespace std;
+
+// Immutable compressed-sparse-row snapshot of a graph with weights of type W.
+// Row u is adj[offsets[u] .. offsets[u+1]) sorted ascending, weights[] runs parallel to adj[].
+// The arrays are read through plain pointers so they can live in vectors built here or in a
+// memory-mapped graph file (see graphFile.h); owner keeps whichever it is alive, and copies
+// of a CSRGraph share it.
+template <class W = int>
+class CSRGraph {
+    int V;
+    bool isDirected;
+    const size_t* offsets;      // V+1 row starts
+    const int* adj;             // neighbor ids of all rows, back to back
+    const W* weights;           // weight of each adj[] entry, or null when every weight is 1
+    shared_ptr<const void> owner;
+
+    // Arrays of a CSRGraph built in memory
+    struct Arrays {
+        vector<size_t> offsets;
+        vector<int> adj;
+        vector<W> weights;
+    };
+
+    // Sort every row by neighbor id (used when the source did not yield sorted rows)
+    static void sortRows(Arrays& a);
+
+public:
+    using weight_type = W;
+
+    // Walks one row of adj[] and weights[] together
+    class NeighborIterator {
+        const int* n;
+        const W* w;
+    public:
+        NeighborIterator(const int* n, const W* w) : n(n), w(w) {}
+        int operator*() const { return *n; }
+        W weight() const { return w ? *w : W(1); }
+        NeighborIterator& operator++() { ++n; if (w) ++w; return *this; }
+        bool operator!=(const NeighborIterator& o) const { return n != o.n; }
+    };
+
+    CSRGraph(int V = 0, bool isDirected = false)
+        : CSRGraph(V, isDirected, vector<size_t>(V + 1, 0), vector<int>(), vector<W>()) {}
+
+    // Take ownership of already built arrays (rows must be sorted ascending); empty weights
+    // make an unweighted graph
+    CSRGraph(int V, bool isDirected, vector<size_t> offsets, vector<int> adj, vector<W> weights)
+        : V(V), isDirected(isDirected) {
+        auto a = make_shared<Arrays>(Arrays{std::move(offsets), std::move(adj), std::move(weights)});
+        this->offsets = a->offsets.data();
+        this->adj = a->adj.data();
+        // weighted() tests for null, which data() of an empty vector need not be
+        this->weights = a->weights.empty() ? nullptr : a->weights.data();
+        owner = std::move(a);
+    }
+
+    // View arrays owned by someone else (e.g. a file mapping held by owner); weights may be null
+    CSRGraph(int V, bool isDirected, const size_t* offsets, const int* adj, const W* weights,
+             shared_ptr<const void> owner)
+        : V(V), isDirected(isDirected), offsets(offsets), adj(adj), weights(weights), owner(std::move(owner)) {}
+
+    // Snapshot any graph exposing vertexCount()/directed()/neighbors().
+    // With transposed = true every edge u -> v is stored as v -> u.
+    template <class G>
+    static CSRGraph from(const G& g, bool transposed = false);
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Check if the graph is directed
+    bool directed() const { return isDirected; }
+
+    // Number of stored entries (an undirected edge is stored in both rows)
+    size_t entryCount() const { return offsets[V]; }
+
+    // Degree of a vertex, O(1)
+    int degree(int u) const { return (int)(offsets[u + 1] - offsets[u]); }
+
+    // Check if there is an edge u -> v (binary search in row u)
+    bool hasEdge(int u, int v) const { return find(u, v) >= 0; }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    W weight(int u, int v) const {
+        long long p = find(u, v);
+        return p < 0 ? W(0) : weights ? weights[p] : W(1);
+    }
+
+    // Neighbors of u in ascending order
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        return {NeighborIterator(adj + offsets[u], weights ? weights + offsets[u] : nullptr),
+                NeighborIterator(adj + offsets[u + 1], weights ? weights + offsets[u + 1] : nullptr)};
+    }
+
+    // Index of the entry u -> v in adj[], or -1 if there is no such edge
+    long long find(int u, int v) const {
+        const int* first = adj + offsets[u];
+        const int* last = adj + offsets[u + 1];
+        const int* it = lower_bound(first, last, v);
+        if (it == last || *it != v)
+            return -1;
+        return it - adj;
+    }
+
+    // Index of the first entry of row u in adj[]
+    size_t rowStart(int u) const { return offsets[u]; }
+
+    // Neighbor id stored at entry e of adj[]
+    int neighborAt(size_t e) const { return adj[e]; }
+
+    // Whether weights are stored (false: every edge has weight 1)
+    bool weighted() const { return weights != nullptr; }
+
+    // Bytes of the row starts, neighbors and weights (counted also when they are file-mapped)
+    size_t byteCount() const {
+        return (V + 1) * sizeof(size_t) + entryCount() * (sizeof(int) + (weights ? sizeof(W) : 0));
+    }
+
+    // Raw arrays, as written to a graph file
+    const size_t* offsetData() const { return offsets; }
+    const int* neighborData() const { return adj; }
+    const W* weightData() const { return weights; }
+
+    // Graph with every edge reversed
+    CSRGraph transpose() const { return from(*this, true); }
+};
+
+// True for CSRGraph<W> of any weight type
+template <class G>
+struct IsCSR : false_type {};
+template <class W>
+struct IsCSR<CSRGraph<W>> : true_type {};
+
+// Snapshot of g keeping its own weight type
+template <class G>
+CSRGraph<typename G::weight_type> snapshot(const G& g)
+{
+    return CSRGraph<typename G::weight_type>::from(g);
+}
+
+template <class W>
+template <class G>
+CSRGraph<W> CSRGraph<W>::from(const G& g, bool transposed)
+{
+    int n = g.vertexCount();
+    // Count entries per row, and see whether any weight is not 1 (else no weights are stored)
+    vector<size_t> off(n + 1, 0);
+    bool unit = true;
+    for (int u = 0; u < n; ++u)
+    {
+        auto r = g.neighbors(u);
+        for (auto it = r.begin(); it != r.end(); ++it)
+        {
+            off[(transposed ? *it : u) + 1]++;
+            unit = unit && static_cast<W>(it.weight()) == W(1);
+        }
+    }
+    for (int u = 0; u < n; ++u)
+        off[u + 1] += off[u];
+    // Scatter the edges into their rows
+    Arrays a;
+    a.adj.resize(off[n]);
+    if (!unit)
+        a.weights.resize(off[n]);
+    vector<size_t> pos(off.begin(), off.end() - 1);
+    bool sorted = true;
+    for (int u = 0; u < n; ++u)
+    {
+        auto r = g.neighbors(u);
+        int prev = -1;
+        for (auto it = r.begin(); it != r.end(); ++it)
+        {
+            int v = *it;
+            if (v < prev)
+                sorted = false;
+            prev = v;
+            size_t p = pos[transposed ? v : u]++;
+            a.adj[p] = transposed ? u : v;
+            if (!unit)
+                a.weights[p] = static_cast<W>(it.weight());
+        }
+    }
+    a.offsets = std::move(off);
+    // Rows come out sorted when the source is sorted (transposed rows are filled by ascending u)
+    if (!sorted && !transposed)
+        sortRows(a);
+    return CSRGraph(n, g.directed(), std::move(a.offsets), std::move(a.adj), std::move(a.weights));
+}
+
+// Sort each row together with its weights (if any)
+template <class W>
+void CSRGraph<W>::sortRows(Arrays& arr)
+{
+    auto& adj = arr.adj;
+    auto& weights = arr.weights;
+    if (weights.empty())
+    {
+        for (size_t u = 0; u + 1 < arr.offsets.size(); ++u)
+            sort(adj.begin() + arr.offsets[u], adj.begin() + arr.offsets[u + 1]);
+        return;
+    }
+    vector<int> idx, a;
+    vector<W> w;
+    for (size_t u = 0; u + 1 < arr.offsets.size(); ++u)
+    {
+        size_t b = arr.offsets[u], e = arr.offsets[u + 1];
+        if (is_sorted(adj.begin() + b, adj.begin() + e))
+            continue;
+        idx.resize(e - b);
+        iota(idx.begin(), idx.end(), 0);
+        sort(idx.begin(), idx.end(), [&](int x, int y) { return adj[b + x] < adj[b + y]; });
+        a.assign(adj.begin() + b, adj.begin() + e);
+        w.assign(weights.begin() + b, weights.begin() + e);
+        for (size_t k = 0; k < idx.size(); ++k)
+        {
+            adj[b + k] = a[idx[k]];
+            weights[b + k] = w[idx[k]];
+        }
+    }
+}
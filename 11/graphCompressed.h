@@ -0,0 +1,221 @@
+// ===== graphCompressed.h =====
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "GraphTypes.h"
+#include "graphCSR.h"
+using namespace std;
+
+// Immutable graph whose sorted rows are gap-encoded varints, for sparse graphs too large for CSR.
+// Row u is stored as
+//   skip[(deg-1)/BLOCK]  uint32 byte offsets (from the end of the table) of blocks 1, 2, ...
+//   varints              every BLOCK-th neighbor as its id, the others as the gap to the previous one
+// so a row decodes front to back and hasEdge() binary searches the block starts. Weights are kept
+// plain in entry order (none at all when every weight is 1). Entry indices match CSRGraph's.
+template <class W = int>
+class CompressedGraph {
+public:
+    static constexpr size_t BLOCK = 64; // entries per skip block
+
+private:
+    int V;
+    bool isDirected;
+    vector<size_t> entryStart; // V+1 first entry index of each row (CSR offsets)
+    vector<size_t> byteStart;  // V+1 first byte of each row in bytes[]
+    vector<uint8_t> bytes;     // skip tables and varints of all rows
+    vector<W> weights;         // weight of each entry, or empty when every weight is 1
+
+    // Decode one varint and move p past it
+    static uint32_t readVarint(const uint8_t*& p) {
+        uint32_t b = *p++;
+        if (b < 0x80)
+            return b;
+        uint32_t x = b & 0x7f;
+        int s = 7;
+        do {
+            b = *p++;
+            x |= (b & 0x7f) << s;
+            s += 7;
+        } while (b & 0x80);
+        return x;
+    }
+
+    // Append x as a varint
+    static void writeVarint(vector<uint8_t>& out, uint32_t x) {
+        while (x >= 0x80) {
+            out.push_back((uint8_t)(x | 0x80));
+            x >>= 7;
+        }
+        out.push_back((uint8_t)x);
+    }
+
+    // Number of skip pointers of a row with d entries
+    static size_t skipCount(size_t d) { return d == 0 ? 0 : (d - 1) / BLOCK; }
+
+    // First byte of block b of row u
+    const uint8_t* blockAt(int u, size_t b) const {
+        const uint8_t* row = bytes.data() + byteStart[u];
+        size_t n = skipCount(degree(u));
+        if (b == 0)
+            return row + 4 * n;
+        uint32_t off;
+        memcpy(&off, row + 4 * (b - 1), 4);
+        return row + 4 * n + off;
+    }
+
+public:
+    using weight_type = W;
+
+    // Decodes one row on the fly
+    class NeighborIterator {
+        const uint8_t* p;  // next varint
+        const W* w;        // weights[] or null
+        size_t k;          // entry index of the current neighbor
+        size_t pos;        // position of the current neighbor in its row
+        size_t end;        // entry index past the row
+        int cur;           // current neighbor id
+        void load() {
+            if (k == end)
+                return;
+            uint32_t x = readVarint(p);
+            cur = pos % BLOCK == 0 ? (int)x : cur + (int)x;
+        }
+    public:
+        NeighborIterator(const uint8_t* p, const W* w, size_t k, size_t end)
+            : p(p), w(w), k(k), pos(0), end(end), cur(0) { load(); }
+        int operator*() const { return cur; }
+        W weight() const { return w ? w[k] : W(1); }
+        NeighborIterator& operator++() { ++k; ++pos; load(); return *this; }
+        bool operator!=(const NeighborIterator& o) const { return k != o.k; }
+    };
+
+    CompressedGraph(int V = 0, bool isDirected = false)
+        : V(V), isDirected(isDirected), entryStart(V + 1, 0), byteStart(V + 1, 0) {}
+
+    // Compress any graph exposing vertexCount()/directed()/neighbors() (rows must come out ascending)
+    template <class G>
+    static CompressedGraph from(const G& g);
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Check if the graph is directed
+    bool directed() const { return isDirected; }
+
+    // Number of stored entries (an undirected edge is stored in both rows)
+    size_t entryCount() const { return entryStart[V]; }
+
+    // Bytes held by the encoded rows, weights and row indices
+    size_t byteCount() const {
+        return bytes.size() + weights.size() * sizeof(W) + (entryStart.size() + byteStart.size()) * sizeof(size_t);
+    }
+
+    // Whether weights are stored (false: every edge has weight 1)
+    bool weighted() const { return !weights.empty(); }
+
+    // Degree of a vertex, O(1)
+    int degree(int u) const { return (int)(entryStart[u + 1] - entryStart[u]); }
+
+    // Index of the first entry of row u
+    size_t rowStart(int u) const { return entryStart[u]; }
+
+    // Entry index of u -> v, or -1 (binary search over the block starts, then one block decoded)
+    long long find(int u, int v) const {
+        size_t d = degree(u);
+        if (d == 0)
+            return -1;
+        size_t lo = 0, hi = skipCount(d);
+        while (lo < hi) {
+            size_t mid = (lo + hi + 1) / 2;
+            const uint8_t* q = blockAt(u, mid);
+            if ((int)readVarint(q) <= v)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        const uint8_t* p = blockAt(u, lo);
+        int cur = 0;
+        for (size_t k = lo * BLOCK; k < d && k < (lo + 1) * BLOCK; ++k) {
+            uint32_t x = readVarint(p);
+            cur = k % BLOCK == 0 ? (int)x : cur + (int)x;
+            if (cur >= v)
+                return cur == v ? (long long)(entryStart[u] + k) : -1;
+        }
+        return -1;
+    }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return find(u, v) >= 0; }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    W weight(int u, int v) const {
+        long long p = find(u, v);
+        return p < 0 ? W(0) : weights.empty() ? W(1) : weights[p];
+    }
+
+    // Neighbors of u in ascending order, decoded while iterating
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        const W* w = weights.empty() ? nullptr : weights.data();
+        return {NeighborIterator(blockAt(u, 0), w, entryStart[u], entryStart[u + 1]),
+                NeighborIterator(nullptr, w, entryStart[u + 1], entryStart[u + 1])};
+    }
+};
+
+// True for CompressedGraph<W> of any weight type
+template <class G>
+struct IsCompressed : false_type {};
+template <class W>
+struct IsCompressed<CompressedGraph<W>> : true_type {};
+
+// True for the immutable storages (CSRGraph<W>, CompressedGraph<W>): they have no
+// addEdge()/removeEdge(), and rowStart()/find() give every entry a stable index
+template <class G>
+struct IsFrozen : integral_constant<bool, IsCSR<G>::value || IsCompressed<G>::value> {};
+
+template <class W>
+template <class G>
+CompressedGraph<W> CompressedGraph<W>::from(const G& g)
+{
+    CompressedGraph c(g.vertexCount(), g.directed());
+    vector<W> w;
+    vector<int> row;
+    bool unit = true;
+    for (int u = 0; u < c.V; ++u)
+    {
+        // Gather the row, then write its skip table and varints
+        row.clear();
+        auto r = g.neighbors(u);
+        for (auto it = r.begin(); it != r.end(); ++it)
+        {
+            row.push_back(*it);
+            w.push_back(static_cast<W>(it.weight()));
+            unit = unit && w.back() == W(1);
+        }
+        c.entryStart[u + 1] = c.entryStart[u] + row.size();
+        c.byteStart[u] = c.bytes.size();
+        size_t table = c.bytes.size(), n = skipCount(row.size());
+        c.bytes.resize(table + 4 * n);
+        size_t data = c.bytes.size();
+        for (size_t k = 0; k < row.size(); ++k)
+        {
+            if (k % BLOCK == 0)
+            {
+                if (k > 0)
+                {
+                    uint32_t off = (uint32_t)(c.bytes.size() - data);
+                    memcpy(c.bytes.data() + table + 4 * (k / BLOCK - 1), &off, 4);
+                }
+                writeVarint(c.bytes, (uint32_t)row[k]);
+            }
+            else
+                writeVarint(c.bytes, (uint32_t)(row[k] - row[k - 1]));
+        }
+    }
+    c.byteStart[c.V] = c.bytes.size();
+    c.bytes.shrink_to_fit();
+    if (!unit)
+        c.weights = std::move(w);
+    return c;
+}
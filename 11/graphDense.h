@@ -0,0 +1,107 @@
+// ===== graphDense.h =====
+#pragma once
+#include "AlignedBuffer.h"
+#include "GraphTypes.h"
+using namespace std;
+
+// Weighted adjacency matrix: cell (u, v) holds the weight of edge u -> v, 0 means no edge.
+// W is the cell type (uint8_t, uint16_t, int32_t or float), so small weights take less memory.
+// All rows live in one cache-line aligned allocation; each row is padded to whole 64-byte
+// lines so every row starts on its own line.
+template <class W>
+class DenseMatrix {
+    int V; // number of vertices
+    bool isDirected;
+    size_t stride;          // cells per row including padding
+    AlignedBuffer<W> cells; // V rows of stride cells
+
+    W* rowPtr(int u) { return cells.data() + (size_t)u * stride; }
+    const W* rowPtr(int u) const { return cells.data() + (size_t)u * stride; }
+
+    // Cells per 64-byte line
+    static constexpr size_t LINE_CELLS = 64 / sizeof(W);
+
+public:
+    using weight_type = W;
+
+    // Iterates the non-zero cells of one matrix row in ascending column order
+    class NeighborIterator {
+        const W* row;
+        int j, n;
+        // Advance to the next column holding an edge
+        void skip() { while (j < n && row[j] == 0) ++j; }
+    public:
+        NeighborIterator(const W* row, int j, int n) : row(row), j(j), n(n) { skip(); }
+        int operator*() const { return j; }
+        W weight() const { return row[j]; }
+        NeighborIterator& operator++() { ++j; skip(); return *this; }
+        bool operator!=(const NeighborIterator& o) const { return j != o.j; }
+    };
+
+    DenseMatrix(int V = 0, bool isDirected = false)
+        : V(V), isDirected(isDirected), stride(((size_t)V + LINE_CELLS - 1) / LINE_CELLS * LINE_CELLS),
+          cells((size_t)V * stride) {}
+
+    // Copy a matrix with another cell type (used when weights outgrow W)
+    template <class W2>
+    explicit DenseMatrix(const DenseMatrix<W2>& o) : DenseMatrix(o.vertexCount(), o.directed()) {
+        for (int u = 0; u < V; ++u) {
+            RowSpan<W2> r = o.row(u);
+            W* dst = rowPtr(u);
+            for (int j = 0; j < V; ++j)
+                dst[j] = static_cast<W>(r[j]);
+        }
+    }
+
+    // Set the weight of edge u-v (both cells if undirected)
+    void addEdge(int u, int v, W weight) {
+        rowPtr(u)[v] = weight;
+        if (!isDirected)
+            rowPtr(v)[u] = weight;
+    }
+
+    // Clear edge u-v
+    void removeEdge(int u, int v) { addEdge(u, v, 0); }
+
+    // Degree of a vertex (scans the whole row)
+    int degree(int u) const {
+        const W* row = rowPtr(u);
+        int deg = 0;
+        for (int j = 0; j < V; j++)
+            deg += row[j] != 0; // if there is an edge between u and j with non-zero weight
+        return deg;
+    }
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Check if the graph is directed
+    bool directed() const { return isDirected; }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return rowPtr(u)[v] != 0; }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    W weight(int u, int v) const { return rowPtr(u)[v]; }
+
+    // Where the cells were placed (see GraphMemory)
+    const MemoryPlacement& placement() const { return cells.placement(); }
+
+    // Bytes held by the cells, row padding included
+    size_t byteCount() const { return cells.size() * sizeof(W); }
+
+    // Row u of the matrix (V cells, padding excluded)
+    RowSpan<W> row(int u) const { return {rowPtr(u), V}; }
+
+    // Neighbors of u in ascending order (scans the whole row)
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        const W* row = rowPtr(u);
+        return {NeighborIterator(row, 0, V), NeighborIterator(row, V, V)};
+    }
+};
+
+// True for DenseMatrix<W> of any weight type
+template <class G>
+struct IsDense : false_type {};
+template <class W>
+struct IsDense<DenseMatrix<W>> : true_type {};
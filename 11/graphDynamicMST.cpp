@@ -0,0 +1,335 @@
+// ===== graphDynamicMST.cpp =====
+#include "graphDynamicMST.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "UnionFind.h"
+using namespace std;
+
+// Spare edges tried before reconnect() searches the smaller half
+static const int SPARE_TRIES = 64;
+
+DynamicMST::DynamicMST(int V)
+    : V(max(V, 0)), isDirected(false), nodes(this->V), incident(this->V), mark(this->V, 0), trees(this->V) {}
+
+DynamicMST::DynamicMST(const Graph& g) : DynamicMST(g.vertexCount()) {
+    isDirected = g.directed();
+    if (isDirected)
+        return;
+    g.visit([&](const auto& m) {
+        for (int u = 0; u < V; ++u) {
+            auto r = m.neighbors(u);
+            for (auto it = r.begin(); it != r.end(); ++it)
+                if (*it > u)
+                    record(u, *it, (double)it.weight());
+        }
+    });
+    // Edges in (weight, id) order; each one joining two trees is a forest edge
+    vector<int> order(edgeList.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) { return heavier(V + b, V + a); });
+    UnionFind joined(V);
+    for (int e : order)
+        if (joined.unite(edgeList[e].u, edgeList[e].v))
+            attach(e);
+        else
+            spare.insert(spare.end(), {edgeList[e].w, e});
+}
+
+uint64_t DynamicMST::pairKey(int u, int v) {
+    if (u > v)
+        swap(u, v);
+    return (uint64_t)u << 32 | (uint32_t)v;
+}
+
+bool DynamicMST::heavier(int a, int b) const {
+    const EdgeRecord &x = edgeList[a - V], &y = edgeList[b - V];
+    return x.w != y.w ? x.w > y.w : a > b;
+}
+
+// ---------- link-cut tree ----------
+
+bool DynamicMST::isSplayRoot(int x) const {
+    int p = nodes[x].parent;
+    return p < 0 || (nodes[p].ch[0] != x && nodes[p].ch[1] != x);
+}
+
+void DynamicMST::push(int x) {
+    Node& n = nodes[x];
+    if (!n.flip)
+        return;
+    swap(n.ch[0], n.ch[1]);
+    for (int c : n.ch)
+        if (c >= 0)
+            nodes[c].flip = !nodes[c].flip;
+    n.flip = false;
+}
+
+void DynamicMST::pull(int x) {
+    Node& n = nodes[x];
+    n.heaviest = x >= V ? x : -1;
+    for (int c : n.ch)
+        if (c >= 0) {
+            int h = nodes[c].heaviest;
+            if (h >= 0 && (n.heaviest < 0 || heavier(h, n.heaviest)))
+                n.heaviest = h;
+        }
+}
+
+void DynamicMST::rotate(int x) {
+    int p = nodes[x].parent, g = nodes[p].parent;
+    int side = nodes[p].ch[1] == x;
+    int inner = nodes[x].ch[side ^ 1];
+    if (!isSplayRoot(p))
+        nodes[g].ch[nodes[g].ch[1] == p] = x;
+    nodes[x].parent = g; // keeps the path parent when p was the splay root
+    nodes[x].ch[side ^ 1] = p;
+    nodes[p].parent = x;
+    nodes[p].ch[side] = inner;
+    if (inner >= 0)
+        nodes[inner].parent = p;
+    pull(p);
+    pull(x);
+}
+
+void DynamicMST::splay(int x) {
+    path.clear();
+    for (int y = x;; y = nodes[y].parent) {
+        path.push_back(y);
+        if (isSplayRoot(y))
+            break;
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+        push(*it);
+    while (!isSplayRoot(x)) {
+        int p = nodes[x].parent;
+        if (!isSplayRoot(p)) {
+            int g = nodes[p].parent;
+            bool zigzig = (nodes[g].ch[1] == p) == (nodes[p].ch[1] == x);
+            rotate(zigzig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+// Make the tree path from the root to x preferred, x at the root of its splay tree
+void DynamicMST::access(int x) {
+    for (int last = -1, y = x; y >= 0; last = y, y = nodes[y].parent) {
+        splay(y);
+        nodes[y].ch[1] = last;
+        pull(y);
+    }
+    splay(x);
+}
+
+// Make x the root of its tree
+void DynamicMST::evert(int x) {
+    access(x);
+    nodes[x].flip = !nodes[x].flip;
+}
+
+int DynamicMST::findRoot(int x) {
+    access(x);
+    for (;;) {
+        push(x);
+        if (nodes[x].ch[0] < 0)
+            break;
+        x = nodes[x].ch[0];
+    }
+    splay(x);
+    return x;
+}
+
+// x and y in different trees
+void DynamicMST::link(int x, int y) {
+    evert(x);
+    nodes[x].parent = y;
+}
+
+// x and y adjacent in one tree
+void DynamicMST::cut(int x, int y) {
+    evert(x);
+    access(y);
+    // The path is x, y: x is the whole left subtree of y
+    nodes[y].ch[0] = -1;
+    nodes[x].parent = -1;
+    pull(y);
+}
+
+int DynamicMST::pathHeaviest(int x, int y) {
+    evert(x);
+    access(y);
+    return nodes[y].heaviest;
+}
+
+bool DynamicMST::connected(int u, int v) {
+    if (u < 0 || u >= V || v < 0 || v >= V)
+        return false;
+    return u == v || findRoot(u) == findRoot(v);
+}
+
+// ---------- forest maintenance ----------
+
+void DynamicMST::attach(int e) {
+    EdgeRecord& r = edgeList[e];
+    int x = V + e;
+    nodes[x] = Node();
+    nodes[x].heaviest = x;
+    link(r.u, x);
+    link(x, r.v);
+    r.inForest = true;
+    total += r.w;
+    --trees;
+}
+
+void DynamicMST::detach(int e) {
+    EdgeRecord& r = edgeList[e];
+    int x = V + e;
+    cut(r.u, x);
+    cut(x, r.v);
+    r.inForest = false;
+    total -= r.w;
+    ++trees;
+}
+
+int DynamicMST::record(int u, int v, double w) {
+    int e;
+    if (!freeIds.empty()) {
+        e = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        e = (int)edgeList.size();
+        edgeList.push_back({});
+        nodes.emplace_back();
+    }
+    edgeList[e] = {u, v, w, false, {(int)incident[u].size(), (int)incident[v].size()}};
+    incident[u].push_back(e);
+    incident[v].push_back(e);
+    ids[pairKey(u, v)] = e;
+    ++liveEdges;
+    return e;
+}
+
+void DynamicMST::insert(int u, int v, double w) {
+    int e = record(u, v, w);
+    if (findRoot(u) != findRoot(v)) {
+        attach(e);
+        return;
+    }
+    // u-v closes a cycle: it replaces the heaviest edge on the tree path if that one is heavier
+    int h = pathHeaviest(u, v);
+    if (heavier(V + e, h)) {
+        spare.insert({w, e});
+        return;
+    }
+    detach(h - V);
+    spare.insert({edgeList[h - V].w, h - V});
+    attach(e);
+}
+
+void DynamicMST::erase(int e) {
+    EdgeRecord& r = edgeList[e];
+    ids.erase(pairKey(r.u, r.v));
+    --liveEdges;
+    // Swap-remove e from both incidence lists
+    for (int side = 0; side < 2; ++side) {
+        vector<int>& list = incident[side ? r.v : r.u];
+        int moved = list.back();
+        list[r.at[side]] = moved;
+        EdgeRecord& m = edgeList[moved];
+        m.at[m.u == (side ? r.v : r.u) ? 0 : 1] = r.at[side];
+        list.pop_back();
+    }
+    if (!r.inForest)
+        spare.erase({r.w, e});
+    else {
+        detach(e);
+        reconnect(r.u, r.v);
+    }
+    freeIds.push_back(e);
+}
+
+void DynamicMST::reconnect(int a, int b) {
+    // The lightest spare edges first: when the halves are of similar size one of them likely
+    // crosses, and the first crossing one in weight order is the lightest of all
+    int tries = 0;
+    for (auto it = spare.begin(); it != spare.end() && tries < SPARE_TRIES; ++it, ++tries) {
+        int f = it->second;
+        if (findRoot(edgeList[f].u) != findRoot(edgeList[f].v)) {
+            spare.erase(it);
+            attach(f);
+            return;
+        }
+    }
+    if (tries < SPARE_TRIES)
+        return; // every spare edge was tried
+    // Walk the forest from a and b in turns; the walk that runs out first has the smaller half
+    stamp += 2;
+    if (stamp < 2) { // wrapped: clear the old stamps
+        fill(mark.begin(), mark.end(), 0);
+        stamp = 2;
+    }
+    vector<int> seen[2] = {{a}, {b}};
+    size_t next[2] = {0, 0};
+    mark[a] = stamp;
+    mark[b] = stamp + 1;
+    int small = -1;
+    while (small < 0)
+        for (int s = 0; s < 2 && small < 0; ++s) {
+            if (next[s] == seen[s].size()) {
+                small = s;
+                break;
+            }
+            int x = seen[s][next[s]++];
+            for (int f : incident[x]) {
+                const EdgeRecord& r = edgeList[f];
+                int y = r.u == x ? r.v : r.u;
+                if (r.inForest && mark[y] != stamp + s) {
+                    mark[y] = stamp + s;
+                    seen[s].push_back(y);
+                }
+            }
+        }
+    // Lightest spare edge leaving the smaller half
+    int best = -1;
+    for (int x : seen[small])
+        for (int f : incident[x]) {
+            const EdgeRecord& r = edgeList[f];
+            int y = r.u == x ? r.v : r.u;
+            if (!r.inForest && mark[y] != stamp + small && (best < 0 || heavier(V + best, V + f)))
+                best = f;
+        }
+    if (best >= 0) {
+        spare.erase({edgeList[best].w, best});
+        attach(best);
+    }
+}
+
+bool DynamicMST::addEdge(int u, int v, double weight) {
+    if (isDirected || u < 0 || u >= V || v < 0 || v >= V || u == v || !(weight < 0 || weight > 0))
+        return false;
+    auto it = ids.find(pairKey(u, v));
+    if (it != ids.end()) {
+        if (edgeList[it->second].w == weight)
+            return false;
+        erase(it->second);
+    }
+    insert(u, v, weight);
+    return true;
+}
+
+bool DynamicMST::removeEdge(int u, int v) {
+    if (isDirected || u < 0 || u >= V || v < 0 || v >= V)
+        return false;
+    auto it = ids.find(pairKey(u, v));
+    if (it == ids.end())
+        return false;
+    erase(it->second);
+    return true;
+}
+
+long long DynamicMST::mstWeight() const {
+    if (isDirected || trees > 1)
+        return -1;
+    return llround(total);
+}
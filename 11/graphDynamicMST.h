@@ -0,0 +1,118 @@
+// ===== graphDynamicMST.h =====
+#pragma once
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "graph.h"
+using namespace std;
+
+// Minimum spanning forest of an undirected graph that changes by single edges, kept next to the
+// Graph: apply every addEdge/removeEdge to both, then read mstWeight() in O(1) instead of running
+// algoMST again. The forest lives in a link-cut tree in which every tree edge is a node of its
+// own, so the heaviest edge on a tree path is found in O(log V) amortized.
+//  - adding an edge, and removing one outside the forest, take O(log V) amortized: a new edge
+//    joins two trees, or replaces the heaviest edge on the path it closes if that one is heavier;
+//  - removing a forest edge cuts it and looks for the lightest edge joining the two halves again:
+//    first among the few lightest non-forest edges (O(log V) each; enough when the halves are of
+//    similar size), then over the edges of the smaller half, found by walking both halves at
+//    once: O(s log V) for the s vertices and edges on the smaller side.
+// Edges are ordered by (weight, id), so ties never leave the forest ambiguous. A directed graph
+// has no MST here: nothing is recorded and mstWeight() is -1, as in algoMST.
+class DynamicMST {
+    // Non-forest edges by weight: (weight, edge id)
+    using Key = pair<double, int>;
+
+    struct EdgeRecord {
+        int u, v;
+        double w;
+        bool inForest;
+        int at[2]; // positions in incident[u] and incident[v]
+    };
+
+    // Link-cut tree node: vertices are nodes 0..V-1, edge id e is node V + e
+    struct Node {
+        int ch[2] = {-1, -1};
+        int parent = -1;  // splay parent, or path parent when this is the root of its splay tree
+        bool flip = false; // children of the subtree are swapped lazily (evert)
+        int heaviest = -1; // edge node of greatest (weight, id) in the splay subtree, -1 if none
+    };
+
+    int V;
+    bool isDirected;
+    vector<EdgeRecord> edgeList;
+    vector<int> freeIds;
+    unordered_map<uint64_t, int> ids; // edge id of each pair u < v
+    set<Key> spare;                   // edges outside the forest
+    vector<Node> nodes;
+    vector<int> path;   // splay(): ancestors whose flips are pushed down first
+    vector<vector<int>> incident; // edge ids at each vertex
+    vector<uint32_t> mark;        // reconnect(): side of each vertex reached, by stamp
+    uint32_t stamp = 0;
+    double total = 0;   // weight of the forest
+    int trees;          // number of trees in the forest (isolated vertices included)
+    long long liveEdges = 0;
+
+    static uint64_t pairKey(int u, int v);
+    bool heavier(int a, int b) const; // edge node a after edge node b in (weight, id) order
+
+    // Link-cut tree primitives
+    bool isSplayRoot(int x) const;
+    void push(int x);
+    void pull(int x);
+    void rotate(int x);
+    void splay(int x);
+    void access(int x);
+    void evert(int x);
+    int findRoot(int x);
+    void link(int x, int y);
+    void cut(int x, int y);
+    int pathHeaviest(int x, int y); // heaviest edge node on the tree path x..y (connected)
+
+    // Put edge id e into the forest / take it out
+    void attach(int e);
+    void detach(int e);
+    // Record a new edge (in neither the forest nor spare yet); returns its id
+    int record(int u, int v, double w);
+    // Record a new edge and place it (forest or spare)
+    void insert(int u, int v, double w);
+    // Forget edge id e, repairing the forest if it was a forest edge
+    void erase(int e);
+    // After a forest edge a-b was cut: attach the lightest edge joining the halves, if any
+    void reconnect(int a, int b);
+
+public:
+    // Empty undirected graph on V vertices
+    explicit DynamicMST(int V);
+
+    // Forest of the edges of g, built as Kruskal builds it (O(E log E))
+    explicit DynamicMST(const Graph& g);
+
+    // Add edge u-v; an existing edge takes the new weight, as in Graph::addEdge. False, with the
+    // forest unchanged, if a vertex is out of range, u == v, the weight is 0 or NaN (as in
+    // Graph, where 0 means no edge), the edge already has this weight or the graph is directed.
+    // Negative weights are allowed. No diagnostics are written.
+    bool addEdge(int u, int v, double weight = 1);
+
+    // Remove edge u-v; false if there is none
+    bool removeEdge(int u, int v);
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Number of edges
+    long long edgeCount() const { return liveEdges; }
+
+    // Number of connected components (isolated vertices included)
+    int components() const { return trees; }
+
+    // Weight of the minimum spanning forest
+    double forestWeight() const { return total; }
+
+    // MST total weight, rounded as algoMST::mstWeight rounds it; -1 if not connected or directed
+    long long mstWeight() const;
+
+    // Whether u and v are in the same component (O(log V) amortized)
+    bool connected(int u, int v);
+};
@@ -0,0 +1,281 @@
+// ===== graphFile.cpp =====
+#include "graphFile.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <memory>
+#include <climits>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+static_assert(sizeof(size_t) == sizeof(uint64_t), "graph files store offsets as 64-bit size_t");
+
+static const char MAGIC[8] = "OSGRAPH";
+
+// Round a byte position up to the next 64-byte boundary
+static uint64_t alignUp(uint64_t pos) { return (pos + 63) / 64 * 64; }
+
+// WeightType of cell type W
+template <class W>
+static WeightType typeOf() {
+    if (is_same<W, uint16_t>::value) return WeightType::U16;
+    if (is_same<W, int32_t>::value)  return WeightType::I32;
+    if (is_same<W, float>::value)    return WeightType::F32;
+    return WeightType::U8;
+}
+
+// Write n bytes at pos, padding with zeros from the current end of the file
+static void put(ofstream& out, uint64_t& end, uint64_t pos, const void* data, size_t n) {
+    static const char zeros[64] = {};
+    out.write(zeros, pos - end);
+    out.write(static_cast<const char*>(data), n);
+    end = pos + n;
+}
+
+template <class W>
+bool GraphFile::write(const string& path, const CSRGraph<W>& g) {
+    uint64_t V = g.vertexCount(), entries = g.entryCount();
+    // Weighted degrees, the count of non-unit weights and the edge hash are stored so open() need not scan
+    vector<double> wdeg(V, 0.0);
+    uint64_t weightedEdges = 0;
+    GraphFingerprint hash;
+    for (uint64_t u = 0; u < V; ++u) {
+        auto r = g.neighbors((int)u);
+        for (auto it = r.begin(); it != r.end(); ++it) {
+            wdeg[u] += it.weight();
+            if (g.directed() || (int)u < *it) {
+                weightedEdges += it.weight() != 1;
+                hash.add((int)u, *it, it.weight(), g.directed());
+            }
+        }
+    }
+    bool weighted = g.weighted() && weightedEdges > 0;
+
+    GraphFileHeader h{};
+    memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.flags = (g.directed() ? FLAG_DIRECTED : 0) | (weighted ? FLAG_WEIGHTED : 0);
+    h.weightType = (uint32_t)typeOf<W>();
+    h.vertices = V;
+    h.entries = entries;
+    h.weightedEdges = weightedEdges;
+    h.offsetsAt = alignUp(sizeof(h));
+    h.neighborsAt = alignUp(h.offsetsAt + (V + 1) * sizeof(uint64_t));
+    uint64_t next = alignUp(h.neighborsAt + entries * sizeof(int32_t));
+    if (weighted) {
+        h.weightsAt = next;
+        next = alignUp(h.weightsAt + entries * sizeof(W));
+    }
+    h.wdegAt = next;
+    h.hashLo = hash.lo;
+    h.hashHi = hash.hi;
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        cerr << "Error: Cannot create graph file " << path << "." << endl;
+        return false;
+    }
+    uint64_t end = 0;
+    put(out, end, 0, &h, sizeof(h));
+    put(out, end, h.offsetsAt, g.offsetData(), (V + 1) * sizeof(uint64_t));
+    put(out, end, h.neighborsAt, g.neighborData(), entries * sizeof(int32_t));
+    if (weighted)
+        put(out, end, h.weightsAt, g.weightData(), entries * sizeof(W));
+    put(out, end, h.wdegAt, wdeg.data(), V * sizeof(double));
+    if (!out) {
+        cerr << "Error: Failed writing graph file " << path << "." << endl;
+        return false;
+    }
+    return true;
+}
+
+template bool GraphFile::write<uint8_t>(const string&, const CSRGraph<uint8_t>&);
+template bool GraphFile::write<uint16_t>(const string&, const CSRGraph<uint16_t>&);
+template bool GraphFile::write<int32_t>(const string&, const CSRGraph<int32_t>&);
+template bool GraphFile::write<float>(const string&, const CSRGraph<float>&);
+
+// Write the active storage, through a CSR snapshot unless it already is one
+bool GraphFile::write(const string& path, const Graph& g) {
+    return g.visit([&](const auto& m) {
+        using M = decay_t<decltype(m)>;
+        if constexpr (IsCSR<M>::value)
+            return write(path, m);
+        else
+            return write(path, snapshot(m));
+    });
+}
+
+namespace
+{
+    // A read-only file mapping, unmapped when the last graph using it goes away
+    struct Mapping
+    {
+        void* base;
+        size_t len;
+        Mapping(void* base, size_t len) : base(base), len(len) {}
+        ~Mapping() { munmap(base, len); }
+    };
+}
+
+// Wrap the sections of a mapped file as CSRGraph<W>
+template <class W>
+static GraphStorageVariant viewAs(const GraphFileHeader& h, shared_ptr<const Mapping> map) {
+    const char* base = static_cast<const char*>(map->base);
+    const W* weights = h.weightsAt ? reinterpret_cast<const W*>(base + h.weightsAt) : nullptr;
+    return CSRGraph<W>((int)h.vertices, h.flags & GraphFile::FLAG_DIRECTED,
+                       reinterpret_cast<const size_t*>(base + h.offsetsAt),
+                       reinterpret_cast<const int*>(base + h.neighborsAt), weights, std::move(map));
+}
+
+// Wrap the sections of a mapped file with the weight type named in the header
+static GraphStorageVariant view(const GraphFileHeader& h, shared_ptr<const Mapping> map) {
+    switch ((WeightType)h.weightType) {
+        case WeightType::U8:  return viewAs<uint8_t>(h, std::move(map));
+        case WeightType::U16: return viewAs<uint16_t>(h, std::move(map));
+        case WeightType::F32: return viewAs<float>(h, std::move(map));
+        default:              return viewAs<int32_t>(h, std::move(map));
+    }
+}
+
+// Check the rows of a mapped CSR (offsets already checked) hold what CSRGraph and the algorithms
+// assume: neighbor ids in range, strictly ascending (sorted, no duplicates), no self-loops,
+// non-zero weights, and for an undirected graph every edge in both rows with the same weight.
+// O(E log d) for the symmetry lookups.
+template <class W>
+static bool wellFormed(const CSRGraph<W>& g) {
+    int V = g.vertexCount();
+    const W* w = g.weightData();
+    for (int u = 0; u < V; ++u) {
+        for (size_t k = g.rowStart(u), e = g.rowStart(u + 1); k < e; ++k) {
+            int v = g.neighborAt(k);
+            if (v < 0 || v >= V || v == u || (k > g.rowStart(u) && v <= g.neighborAt(k - 1)))
+                return false;
+            if (w && !(w[k] < 0 || w[k] > 0)) // 0 or NaN
+                return false;
+        }
+    }
+    if (g.directed())
+        return true;
+    for (int u = 0; u < V; ++u) {
+        for (size_t k = g.rowStart(u), e = g.rowStart(u + 1); k < e; ++k) {
+            int v = g.neighborAt(k);
+            long long p = g.find(v, u);
+            if (p < 0 || (w && w[p] != w[k]))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Size of one weight of the given WeightType, or 0 if it is not one
+static size_t weightBytes(uint32_t t) {
+    switch ((WeightType)t) {
+        case WeightType::U8:  return 1;
+        case WeightType::U16: return 2;
+        case WeightType::I32:
+        case WeightType::F32: return 4;
+    }
+    return 0;
+}
+
+// Check that the header describes sections lying inside a file of len bytes
+static bool validHeader(const GraphFileHeader& h, uint64_t len) {
+    if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != GraphFile::VERSION)
+        return false;
+    size_t wb = weightBytes(h.weightType);
+    if (wb == 0 || h.vertices > (uint64_t)INT32_MAX || h.entries > len)
+        return false;
+    auto inside = [len](uint64_t at, uint64_t bytes) { return at % 64 == 0 && at <= len && bytes <= len - at; };
+    bool weighted = h.flags & GraphFile::FLAG_WEIGHTED;
+    return inside(h.offsetsAt, (h.vertices + 1) * sizeof(uint64_t)) &&
+           inside(h.neighborsAt, h.entries * sizeof(int32_t)) &&
+           (!weighted || (h.weightsAt != 0 && inside(h.weightsAt, h.entries * wb))) &&
+           (weighted || h.weightsAt == 0) &&
+           inside(h.wdegAt, h.vertices * sizeof(double));
+}
+
+bool GraphFile::open(const string& path, Graph& out, bool verify) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Error: Cannot open graph file " << path << "." << endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)) {
+        ::close(fd);
+        cerr << "Error: " << path << " is not a graph file." << endl;
+        return false;
+    }
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        cerr << "Error: Cannot map graph file " << path << "." << endl;
+        return false;
+    }
+    auto map = make_shared<const Mapping>(base, (size_t)st.st_size);
+
+    GraphFileHeader h;
+    memcpy(&h, base, sizeof(h));
+    if (!validHeader(h, st.st_size)) {
+        cerr << "Error: " << path << " is not a valid graph file." << endl;
+        return false;
+    }
+    // Rows must not overlap or run past neighbors[]: offsets start at 0, never decrease and end
+    // at entries
+    const size_t* offsets = reinterpret_cast<const size_t*>(static_cast<const char*>(base) + h.offsetsAt);
+    bool ok = offsets[0] == 0 && offsets[h.vertices] == h.entries;
+    for (uint64_t u = 0; ok && u < h.vertices; ++u)
+        ok = offsets[u] <= offsets[u + 1];
+    GraphStorageVariant csr;
+    if (ok) {
+        csr = view(h, map);
+        if (verify)
+            ok = std::visit([](const auto& m) {
+                if constexpr (IsCSR<decay_t<decltype(m)>>::value)
+                    return wellFormed(m);
+                else
+                    return false;
+            }, csr);
+    }
+    if (!ok) {
+        cerr << "Error: " << path << " is not a valid graph file." << endl;
+        return false;
+    }
+
+    if (verify) {
+        // Empty weighted degrees make the Graph compute them, the weight count and the hash
+        out = Graph(std::move(csr), {}, -1);
+        return true;
+    }
+    const double* wdeg = reinterpret_cast<const double*>(static_cast<const char*>(base) + h.wdegAt);
+    out = Graph(std::move(csr), vector<double>(wdeg, wdeg + h.vertices), (long long)h.weightedEdges,
+                GraphFingerprint{h.hashLo, h.hashHi});
+    return true;
+}
+
+bool GraphFile::inDirectory(const string& dir, const string& name, string& path) {
+    if (dir.empty() || name.empty() || name[0] == '/')
+        return false;
+    for (size_t b = 0; b <= name.size();) {
+        size_t e = name.find('/', b);
+        if (e == string::npos)
+            e = name.size();
+        if (name.compare(b, e - b, "..") == 0)
+            return false;
+        b = e + 1;
+    }
+    // Symlinks may still lead out: compare the resolved paths
+    char root[PATH_MAX], file[PATH_MAX];
+    string joined = dir + "/" + name;
+    if (!realpath(dir.c_str(), root) || !realpath(joined.c_str(), file))
+        return false;
+    size_t n = strlen(root);
+    if (strncmp(file, root, n) != 0 || (file[n] != '/' && !(n == 1 && root[0] == '/')))
+        return false;
+    path = file;
+    return true;
+}
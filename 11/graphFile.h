@@ -0,0 +1,58 @@
+// ===== graphFile.h =====
+#pragma once
+#include <string>
+#include <cstdint>
+#include "graph.h"
+using namespace std;
+
+// Binary graph file, written in native byte order and opened with mmap:
+//
+//   GraphFileHeader
+//   offsets   uint64_t[V+1]        row starts (CSR)
+//   neighbors int32_t[entries]     sorted neighbor ids of every row
+//   weights   W[entries]           only if FLAG_WEIGHTED; W is given by weightType
+//   wdeg      double[V]            weighted degree of every vertex
+//
+// Every section starts on a 64-byte boundary. An undirected edge is stored in both rows.
+struct GraphFileHeader {
+    char magic[8];           // "OSGRAPH"
+    uint32_t version;        // GraphFile::VERSION
+    uint32_t flags;          // FLAG_DIRECTED | FLAG_WEIGHTED
+    uint32_t weightType;     // WeightType of the weights section
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t entries;        // length of neighbors[]
+    uint64_t weightedEdges;  // edges whose weight is not 1
+    uint64_t offsetsAt;      // byte position of each section
+    uint64_t neighborsAt;
+    uint64_t weightsAt;      // 0 if there is no weights section
+    uint64_t wdegAt;
+    uint64_t hashLo;         // edge hash (GraphFingerprint) so open() need not scan
+    uint64_t hashHi;
+};
+
+class GraphFile {
+public:
+    static constexpr uint32_t VERSION = 3; // 3: integral weights hashed exactly
+    static constexpr uint32_t FLAG_DIRECTED = 1;
+    static constexpr uint32_t FLAG_WEIGHTED = 2;
+
+    // Write g to path (the weights section is left out when every weight is 1).
+    // Returns false and prints the reason on cerr on failure.
+    static bool write(const string& path, const Graph& g);
+    template <class W>
+    static bool write(const string& path, const CSRGraph<W>& g);
+
+    // Map the file at path into out without reading the edges: out gets CSR storage that
+    // points into the mapping, which stays alive as long as out (or a copy of it) does.
+    // The row offsets are always checked (O(V)). With verify, for files from untrusted sources,
+    // every row is checked too (ids in range and strictly ascending, no self-loops, non-zero
+    // weights, undirected edges in both rows alike; O(E log d)) and the degrees, weight count and
+    // fingerprint are recomputed from the edges instead of taken from the header.
+    // Returns false and prints the reason on cerr on failure.
+    static bool open(const string& path, Graph& out, bool verify = false);
+
+    // Path of the file name inside directory dir, for names taken from requests. False if name is
+    // empty or absolute, has a ".." component, or resolves (through symlinks) outside dir.
+    static bool inDirectory(const string& dir, const string& name, string& path);
+};
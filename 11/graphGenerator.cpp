@@ -0,0 +1,498 @@
+// ===== graphGenerator.cpp =====
+#include "graphGenerator.h"
+#include "graphThreads.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+using namespace std;
+
+namespace
+{
+    // The first M distinct values of scaled(counterDraw(seed, i), N) for i = 0, 1, ..., ascending.
+    // Draws are split between T threads by index and between T buckets by value, so the result
+    // does not depend on T.
+    vector<uint64_t> firstDistinct(uint64_t N, uint64_t M, uint64_t seed, int T) {
+        if (M == 0)
+            return {};
+        // Draws expected to show M distinct values, plus slack; rarely too few, then 25% more
+        uint64_t C = (uint64_t)(-(double)N * log1p(-(double)M / N)) + 4 * (uint64_t)sqrt((double)M) + 16;
+        for (;; C += C / 4) {
+            auto value = [&](uint64_t i) { return GraphGenerator::scaled(GraphGenerator::counterDraw(seed, i), N); };
+            auto bucket = [&](uint64_t v) { return (int)((unsigned __int128)v * T / N); };
+
+            // Count, then scatter (value, draw) into buckets ordered by value
+            vector<vector<uint64_t>> pos(T, vector<uint64_t>(T, 0)); // pos[t][b]
+            runThreads(T, [&](int t) {
+                for (uint64_t i = share(C, t, T); i < share(C, t + 1, T); ++i)
+                    pos[t][bucket(value(i))]++;
+            });
+            vector<uint64_t> bucketStart(T + 1, 0);
+            for (int b = 0; b < T; ++b)
+                for (int t = 0; t < T; ++t) {
+                    uint64_t n = pos[t][b];
+                    pos[t][b] = bucketStart[b + 1];
+                    bucketStart[b + 1] += n;
+                }
+            for (int b = 0; b < T; ++b)
+                bucketStart[b + 1] += bucketStart[b];
+            vector<pair<uint64_t, uint64_t>> ent(C);
+            runThreads(T, [&](int t) {
+                for (uint64_t i = share(C, t, T); i < share(C, t + 1, T); ++i) {
+                    uint64_t v = value(i);
+                    int b = bucket(v);
+                    ent[bucketStart[b] + pos[t][b]++] = {v, i};
+                }
+            });
+
+            // Mark the earliest draw of every value
+            unique_ptr<char[]> first(new char[C]());
+            runThreads(T, [&](int b) {
+                auto lo = ent.begin() + bucketStart[b], hi = ent.begin() + bucketStart[b + 1];
+                sort(lo, hi);
+                for (auto it = lo; it != hi; ++it)
+                    if (it == lo || (it - 1)->first != it->first)
+                        first[it->second] = 1;
+            });
+
+            // Cutoff: the draw that shows the M-th distinct value
+            vector<uint64_t> fresh(T, 0);
+            runThreads(T, [&](int t) {
+                for (uint64_t i = share(C, t, T); i < share(C, t + 1, T); ++i)
+                    fresh[t] += first[i];
+            });
+            uint64_t seen = 0, cutoff = C;
+            for (int t = 0; t < T && cutoff == C; ++t) {
+                if (seen + fresh[t] < M) {
+                    seen += fresh[t];
+                    continue;
+                }
+                for (uint64_t i = share(C, t, T);; ++i)
+                    if (first[i] && ++seen == M) {
+                        cutoff = i;
+                        break;
+                    }
+            }
+            if (cutoff == C)
+                continue;
+
+            // Values first drawn up to the cutoff, bucket by bucket
+            vector<uint64_t> kept(T + 1, 0);
+            runThreads(T, [&](int b) {
+                for (uint64_t k = bucketStart[b]; k < bucketStart[b + 1]; ++k)
+                    kept[b + 1] += first[ent[k].second] && ent[k].second <= cutoff;
+            });
+            for (int b = 0; b < T; ++b)
+                kept[b + 1] += kept[b];
+            vector<uint64_t> out(M);
+            runThreads(T, [&](int b) {
+                uint64_t o = kept[b];
+                for (uint64_t k = bucketStart[b]; k < bucketStart[b + 1]; ++k)
+                    if (first[ent[k].second] && ent[k].second <= cutoff)
+                        out[o++] = ent[k].first;
+            });
+            return out;
+        }
+    }
+}
+
+// Number of pairs (a, b), a < b, with a below i: where row i starts in the pair index space
+static uint64_t rowStart(uint64_t V, uint64_t i) {
+    return i * (2 * V - i - 1) / 2;
+}
+
+Edge GraphGenerator::pairAt(int V, uint64_t k) {
+    double b = 2.0 * V - 1;
+    double est = (b - sqrt(max(0.0, b * b - 8.0 * (double)k))) / 2;
+    uint64_t i = (uint64_t)max(0.0, min(est, (double)(V - 2)));
+    // Rounding can put the estimate a row off either way near row boundaries
+    while (i > 0 && rowStart(V, i) > k)
+        --i;
+    while (i + 1 < (uint64_t)V - 1 && rowStart(V, i + 1) <= k)
+        ++i;
+    return {(int)i, (int)(i + 1 + (k - rowStart(V, i))), 1};
+}
+
+vector<Edge> GraphGenerator::sampleEdges(int V, long long E, uint32_t seed) {
+    vector<Edge> edges;
+    if (V < 2 || E <= 0)
+        return edges;
+    const uint64_t N = (uint64_t)V * (V - 1) / 2;
+    const uint64_t M = min<uint64_t>((uint64_t)E, N);
+    edges.reserve(M);
+    mt19937_64 gen(seed);
+
+    if (2 * M > N) {
+        // Dense: walk all pairs once and keep each with probability needed / remaining,
+        // O(N) = O(E) here and no set of drawn indices
+        uint64_t needed = M, remaining = N;
+        for (int i = 0; i < V && needed; ++i)
+            for (int j = i + 1; j < V && needed; ++j, --remaining)
+                if (uniform_int_distribution<uint64_t>(0, remaining - 1)(gen) < needed) {
+                    edges.push_back({i, j, 1});
+                    --needed;
+                }
+        return edges;
+    }
+
+    // Floyd: for j = N-M .. N-1 draw t in [0, j]; take t, or j itself if t is already taken.
+    // Every M-subset comes out with the same probability after exactly M draws.
+    unordered_set<uint64_t> taken;
+    taken.reserve(M);
+    for (uint64_t j = N - M; j < N; ++j) {
+        uint64_t t = uniform_int_distribution<uint64_t>(0, j)(gen);
+        uint64_t k = t;
+        if (!taken.insert(t).second) {
+            k = j; // j was never drawn before: all earlier draws are below it
+            taken.insert(j);
+        }
+        edges.push_back(pairAt(V, k));
+    }
+    return edges;
+}
+
+Graph GraphGenerator::randomParallel(int V, long long E, uint64_t seed, int threads) {
+    const uint64_t N = V < 2 ? 0 : (uint64_t)V * (V - 1) / 2;
+    const uint64_t M = E <= 0 ? 0 : min<uint64_t>((uint64_t)E, N);
+    int T = threadBudget(threads);
+    T = (int)min<uint64_t>(T, 1 + M / 65536); // small graphs are not worth a thread
+    const bool complement = 2 * M > N;
+    const vector<uint64_t> picked = firstDistinct(N, complement ? N - M : M, seed, T);
+
+    // Call f(u, v) for every edge of part t: picked pairs, or all pairs but the picked ones
+    auto forEdges = [&](int t, auto f) {
+        if (!complement) {
+            for (uint64_t k = share(picked.size(), t, T); k < share(picked.size(), t + 1, T); ++k) {
+                Edge e = pairAt(V, picked[k]);
+                f(e.u, e.v);
+            }
+            return;
+        }
+        uint64_t k = share(N, t, T), end = share(N, t + 1, T);
+        if (k == end)
+            return;
+        auto skip = lower_bound(picked.begin(), picked.end(), k);
+        Edge e = pairAt(V, k);
+        for (int u = e.u, v = e.v; k < end; ++k) {
+            if (skip != picked.end() && *skip == k)
+                ++skip;
+            else
+                f(u, v);
+            if (++v == V) {
+                ++u;
+                v = u + 1;
+            }
+        }
+    };
+
+    if (Graph::chooseStorage(V, (long long)M, false, false) != GraphStorage::Lists) {
+        BitMatrix bits(V, false);
+        runThreads(T, [&](int t) { forEdges(t, [&](int u, int v) { bits.addEdgeAtomic(u, v); }); });
+        return Graph(std::move(bits));
+    }
+
+    // CSR: count both ends, scatter, then sort each row
+    unique_ptr<atomic<size_t>[]> cnt(new atomic<size_t>[V + 1]());
+    runThreads(T, [&](int t) {
+        forEdges(t, [&](int u, int v) {
+            cnt[u + 1].fetch_add(1, memory_order_relaxed);
+            cnt[v + 1].fetch_add(1, memory_order_relaxed);
+        });
+    });
+    vector<size_t> off(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+        off[u + 1] = off[u] + cnt[u + 1].load(memory_order_relaxed);
+    for (int u = 0; u < V; ++u)
+        cnt[u].store(off[u], memory_order_relaxed); // now the next free slot of each row
+    vector<int> adj(off[V]);
+    runThreads(T, [&](int t) {
+        forEdges(t, [&](int u, int v) {
+            adj[cnt[u].fetch_add(1, memory_order_relaxed)] = v;
+            adj[cnt[v].fetch_add(1, memory_order_relaxed)] = u;
+        });
+    });
+    runThreads(T, [&](int t) {
+        for (int u = (int)share(V, t, T); u < (int)share(V, t + 1, T); ++u)
+            sort(adj.begin() + off[u], adj.begin() + off[u + 1]);
+    });
+    return Graph(CSRGraph<int32_t>(V, false, std::move(off), std::move(adj), vector<int32_t>()));
+}
+
+Graph GraphGenerator::random(int V, long long E, uint32_t seed, EdgeSampling how) {
+    if (how == EdgeSampling::Counter)
+        return randomParallel(V, E, seed);
+    Graph g = Graph::forEdges(V, E); // unweighted; storage picked from V and E
+    if (how == EdgeSampling::Floyd) {
+        g.addEdges(sampleEdges(V, E, seed), EdgeCheck::Trusted); // pairs are distinct and i<j
+        return g;
+    }
+
+    mt19937 gen(seed);
+    vector<Edge> all;
+    if (how == EdgeSampling::ShuffleAll) {
+        all.reserve((size_t)V * V);
+        for (int i = 0; i < V; i++)
+            for (int j = 0; j < V; j++)
+                all.push_back({i, j, 1});
+        shuffle(all.begin(), all.end(), gen);
+        // Add edges in shuffled order until reaching E edges (duplicates/self-loops are skipped)
+        g.addEdges(all, EdgeCheck::SkipInvalid, (size_t)E);
+    } else {
+        all.reserve((size_t)V * (V - 1) / 2);
+        for (int i = 0; i < V; i++)
+            for (int j = i + 1; j < V; j++)
+                all.push_back({i, j, 1});
+        shuffle(all.begin(), all.end(), gen);
+        g.addEdges(all, EdgeCheck::Trusted, (size_t)E);
+    }
+    return g;
+}
+
+// Simple undirected CSR of V vertices from edges in any order (repeats and loops are dropped);
+// with maxWeight above 1 every distinct edge gets a weight in [1, maxWeight] drawn from seed
+static Graph buildFamily(int V, vector<Edge> edges, int maxWeight, uint64_t seed) {
+    for (auto& e : edges)
+        if (e.u > e.v)
+            swap(e.u, e.v);
+    auto byPair = [](const Edge& x, const Edge& y) { return x.u != y.u ? x.u < y.u : x.v < y.v; };
+    auto samePair = [](const Edge& x, const Edge& y) { return x.u == y.u && x.v == y.v; };
+    sort(edges.begin(), edges.end(), byPair);
+    edges.erase(unique(edges.begin(), edges.end(), samePair), edges.end());
+    edges.erase(remove_if(edges.begin(), edges.end(), [](const Edge& e) { return e.u == e.v; }), edges.end());
+
+    const bool weighted = maxWeight > 1;
+    const uint64_t weightSeed = seed ^ 0x5DEECE66DULL; // weights do not reuse the edge draws
+    vector<size_t> off(V + 1, 0);
+    for (size_t k = 0; k < edges.size(); ++k) {
+        off[edges[k].u + 1]++;
+        off[edges[k].v + 1]++;
+        if (weighted)
+            edges[k].w = 1 + (int)GraphGenerator::scaled(GraphGenerator::counterDraw(weightSeed, k), (uint64_t)maxWeight);
+    }
+    for (int u = 0; u < V; ++u)
+        off[u + 1] += off[u];
+    vector<size_t> next(off.begin(), off.end() - 1);
+    vector<int> adj(off[V]);
+    vector<int32_t> w(weighted ? off[V] : 0);
+    // Edges are sorted by (u, v), so both ends fill their rows in ascending order
+    for (int pass = 0; pass < 2; ++pass)
+        for (const Edge& e : edges) {
+            int from = pass == 0 ? e.v : e.u, to = pass == 0 ? e.u : e.v;
+            size_t p = next[from]++;
+            adj[p] = to;
+            if (weighted)
+                w[p] = e.w;
+        }
+    return Graph(CSRGraph<int32_t>(V, false, std::move(off), std::move(adj), std::move(w)));
+}
+
+// Edges of an undirected graph, each once (u < v)
+static vector<Edge> edgeList(const Graph& g) {
+    vector<Edge> edges;
+    edges.reserve(g.edgeCount());
+    g.visit([&](const auto& m) {
+        for (int u = 0; u < m.vertexCount(); ++u)
+            for (int v : m.neighbors(u))
+                if (u < v)
+                    edges.push_back({u, v, 1});
+    });
+    return edges;
+}
+
+// R-MAT: every edge descends log2(V) levels of the adjacency matrix, picking a quadrant with
+// probability a, b, c or d at each; draws outside V, loops and repeats are drawn again
+static vector<Edge> rmatEdges(const GeneratorSpec& s) {
+    int scale = 0;
+    while ((1LL << scale) < s.V)
+        ++scale;
+    const uint64_t target = min<uint64_t>(s.E, (uint64_t)s.V * (s.V - 1) / 2);
+    mt19937_64 gen(s.seed);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    unordered_set<uint64_t> seen;
+    seen.reserve(target);
+    vector<Edge> edges;
+    edges.reserve(target);
+    // Dense targets get hard to fill by chance: give up after 16 draws per edge
+    for (uint64_t tries = 0; edges.size() < target && tries < 16 * target + 1024; ++tries) {
+        long long u = 0, v = 0;
+        for (int level = 0; level < scale; ++level) {
+            double r = coin(gen);
+            int right = r >= s.a && (r < s.a + s.b || r >= s.a + s.b + s.c);
+            int down = r >= s.a + s.b;
+            u = 2 * u + down;
+            v = 2 * v + right;
+        }
+        if (u >= s.V || v >= s.V || u == v)
+            continue;
+        if (u > v)
+            swap(u, v);
+        if (seen.insert((uint64_t)u * s.V + v).second)
+            edges.push_back({(int)u, (int)v, 1});
+    }
+    return edges;
+}
+
+// Barabasi-Albert: a clique on m+1 vertices, then every further vertex links to m distinct
+// earlier ones chosen with probability proportional to their degree
+static vector<Edge> preferentialEdges(const GeneratorSpec& s) {
+    int m = (int)max(1LL, min<long long>(s.E / max(1, s.V), s.V - 1));
+    int core = min(s.V, m + 1);
+    vector<Edge> edges;
+    vector<int> ends; // every edge end once: a uniform pick is a degree-proportional vertex
+    for (int u = 0; u < core; ++u)
+        for (int v = u + 1; v < core; ++v) {
+            edges.push_back({u, v, 1});
+            ends.push_back(u);
+            ends.push_back(v);
+        }
+    mt19937_64 gen(s.seed);
+    vector<int> chosen;
+    for (int v = core; v < s.V; ++v) {
+        chosen.clear();
+        while ((int)chosen.size() < m) {
+            int t = ends[uniform_int_distribution<size_t>(0, ends.size() - 1)(gen)];
+            if (find(chosen.begin(), chosen.end(), t) == chosen.end())
+                chosen.push_back(t);
+        }
+        for (int t : chosen) {
+            edges.push_back({t, v, 1});
+            ends.push_back(t);
+            ends.push_back(v);
+        }
+    }
+    return edges;
+}
+
+// G(n,m) plus every pair among cliqueSize vertices picked uniformly
+static vector<Edge> plantedCliqueEdges(const GeneratorSpec& s) {
+    vector<Edge> edges = edgeList(GraphGenerator::randomParallel(s.V, s.E, s.seed));
+    int k = s.cliqueSize > 0 ? s.cliqueSize : max(3, (int)sqrt((double)s.V));
+    k = min(k, s.V);
+    vector<int> members(s.V);
+    for (int v = 0; v < s.V; ++v)
+        members[v] = v;
+    mt19937_64 gen(s.seed);
+    for (int i = 0; i < k; ++i) // partial Fisher-Yates: the first k are a uniform k-subset
+        swap(members[i], members[uniform_int_distribution<int>(i, s.V - 1)(gen)]);
+    for (int i = 0; i < k; ++i)
+        for (int j = i + 1; j < k; ++j)
+            edges.push_back({members[i], members[j], 1});
+    return edges;
+}
+
+// Lattice with rows of ceil(sqrt V) vertices, each linked to its right and lower neighbor
+static vector<Edge> gridEdges(const GeneratorSpec& s) {
+    int cols = max(1, (int)ceil(sqrt((double)s.V)));
+    vector<Edge> edges;
+    for (int v = 0; v < s.V; ++v) {
+        if ((v + 1) % cols != 0 && v + 1 < s.V)
+            edges.push_back({v, v + 1, 1});
+        if (v + cols < s.V)
+            edges.push_back({v, v + cols, 1});
+    }
+    return edges;
+}
+
+Graph GraphGenerator::generate(const GeneratorSpec& s) {
+    if (s.family == GraphFamily::Uniform && s.maxWeight <= 1)
+        return randomParallel(s.V, s.E, s.seed);
+    vector<Edge> edges;
+    switch (s.family) {
+        case GraphFamily::Uniform:       edges = edgeList(randomParallel(s.V, s.E, s.seed)); break;
+        case GraphFamily::RMAT:          edges = rmatEdges(s); break;
+        case GraphFamily::Preferential:  edges = preferentialEdges(s); break;
+        case GraphFamily::PlantedClique: edges = plantedCliqueEdges(s); break;
+        case GraphFamily::Grid:          edges = gridEdges(s); break;
+    }
+    return buildFamily(s.V, std::move(edges), s.maxWeight, s.seed);
+}
+
+bool GraphGenerator::parseFamily(const string& name, GraphFamily& out) {
+    if (name == "gnm") out = GraphFamily::Uniform;
+    else if (name == "rmat") out = GraphFamily::RMAT;
+    else if (name == "ba") out = GraphFamily::Preferential;
+    else if (name == "clique") out = GraphFamily::PlantedClique;
+    else if (name == "grid") out = GraphFamily::Grid;
+    else return false;
+    return true;
+}
+
+const char* GraphGenerator::familyName(GraphFamily family) {
+    switch (family) {
+        case GraphFamily::RMAT:          return "rmat";
+        case GraphFamily::Preferential:  return "ba";
+        case GraphFamily::PlantedClique: return "clique";
+        case GraphFamily::Grid:          return "grid";
+        default:                         return "gnm";
+    }
+}
+
+bool GraphGenerator::parseSpec(istream& in, GeneratorSpec& out) {
+    string family;
+    GeneratorSpec s;
+    if (!(in >> family >> s.V >> s.E >> s.seed) || !parseFamily(family, s.family))
+        return false;
+    string opt;
+    while (in >> opt) {
+        size_t eq = opt.find('=');
+        if (eq == string::npos)
+            return false;
+        string key = opt.substr(0, eq);
+        istringstream value(opt.substr(eq + 1));
+        bool ok = key == "k" ? bool(value >> s.cliqueSize)
+                : key == "w" ? bool(value >> s.maxWeight)
+                : key == "a" ? bool(value >> s.a)
+                : key == "b" ? bool(value >> s.b)
+                : key == "c" ? bool(value >> s.c)
+                : false;
+        if (!ok)
+            return false;
+    }
+    long long maxEdges = (long long)s.V * (s.V - 1) / 2;
+    if (s.V <= 0 || s.E < 0 || s.E > maxEdges || s.cliqueSize < 0 || s.cliqueSize > s.V || s.maxWeight < 1)
+        return false;
+    if (s.a < 0 || s.b < 0 || s.c < 0 || s.a + s.b + s.c > 1)
+        return false;
+    out = s;
+    return true;
+}
+
+long long GraphGenerator::edgeBound(const GeneratorSpec& s) {
+    switch (s.family) {
+        case GraphFamily::Grid:
+            return 2LL * s.V;
+        case GraphFamily::PlantedClique: {
+            long long k = s.cliqueSize > 0 ? s.cliqueSize : max(3, (int)sqrt((double)s.V));
+            k = min<long long>(k, s.V);
+            return s.E + k * (k - 1) / 2;
+        }
+        default:
+            return s.E;
+    }
+}
+
+bool GraphBudget::allows(long long V, long long E) const {
+    return V <= maxVertices && E <= maxEdges;
+}
+
+bool GraphBudget::allowsStream(long long V, long long E) const {
+    return V <= maxVertices && E <= maxStreamEdges;
+}
+
+string GeneratorSpec::str() const {
+    ostringstream os;
+    // Every bit of a, b and c: specs that differ must not share a cache key
+    os << setprecision(17);
+    os << GraphGenerator::familyName(family) << " " << V << " " << E << " " << seed;
+    if (family == GraphFamily::PlantedClique && cliqueSize > 0)
+        os << " k=" << cliqueSize;
+    if (maxWeight > 1)
+        os << " w=" << maxWeight;
+    if (family == GraphFamily::RMAT)
+        os << " a=" << a << " b=" << b << " c=" << c;
+    return os.str();
+}
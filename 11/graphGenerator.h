@@ -0,0 +1,107 @@
+// ===== graphGenerator.h =====
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "graph.h"
+using namespace std;
+
+// How a random G(n,m) graph picks its m edges
+enum class EdgeSampling {
+    Floyd,         // O(E) time and memory: distinct indices of the V(V-1)/2 pairs i<j
+    Counter,       // O(E), on all threads: pair indices from a counter-based generator (see randomParallel)
+    ShuffleAll,    // old server sequence: shuffle all V*V ordered pairs, keep the first E valid ones
+    ShufflePairs   // old pipeline server sequence: shuffle the V(V-1)/2 pairs i<j, keep the first E
+};
+
+// Shapes of benchmark graphs (all simple and undirected)
+enum class GraphFamily {
+    Uniform,      // "gnm": G(n,m), E edges uniform over all pairs (randomParallel)
+    RMAT,         // "rmat": recursive matrix / Kronecker: skewed degrees, E distinct edges
+    Preferential, // "ba": Barabasi-Albert, each new vertex attaches E/V edges by degree
+    PlantedClique,// "clique": G(n,m) with E edges plus a clique on cliqueSize random vertices
+    Grid          // "grid": 2D lattice, rows of ceil(sqrt V) vertices (E is not used)
+};
+
+// One benchmark graph: family, size, seed and the options of the family
+struct GeneratorSpec {
+    GraphFamily family = GraphFamily::Uniform;
+    int V = 0;
+    long long E = 0;
+    uint64_t seed = 0;
+    int cliqueSize = 0;                 // PlantedClique: 0 = sqrt(V), at least 3
+    int maxWeight = 1;                  // above 1: weights uniform in [1, maxWeight], else unweighted
+    double a = 0.57, b = 0.19, c = 0.19; // RMAT quadrant probabilities (d = 1 - a - b - c)
+
+    // Canonical text, as parseSpec() reads it ("rmat 1024 8000 7 w=100 a=.. b=.. c=..", the
+    // probabilities printed with 17 digits so that the text tells every spec apart)
+    string str() const;
+};
+
+// Largest graph a server builds or streams for one request; all limits are inclusive. A streamed
+// graph stores no edges (O(V) memory), so it has an edge limit of its own, bounding only the time.
+struct GraphBudget {
+    long long maxVertices = 1LL << 24;
+    long long maxEdges = 1LL << 25;
+    long long maxStreamEdges = 1LL << 34;
+
+    // Whether V vertices and E edges are within the budget
+    bool allows(long long V, long long E) const;
+
+    // Whether a streamed graph of V vertices and E edges is within the budget
+    bool allowsStream(long long V, long long E) const;
+};
+
+// Random simple undirected graphs with exactly E edges, uniform over all such graphs.
+// The same V, E, seed and sampling always give the same graph. The Shuffle* modes only exist
+// to reproduce graphs of existing seeds; they need O(V²) memory and time.
+class GraphGenerator {
+public:
+    // Output index of the splitmix64 stream started at seed: any draw without the ones before it
+    static uint64_t counterDraw(uint64_t seed, uint64_t index) {
+        uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // x scaled to [0, n) (multiply-high)
+    static uint64_t scaled(uint64_t x, uint64_t n) {
+        return (uint64_t)(((unsigned __int128)x * n) >> 64);
+    }
+
+    // Pair i < j with index k, pairs numbered row by row (k < V(V-1)/2)
+    static Edge pairAt(int V, uint64_t k);
+
+    // E distinct pairs (u < v, weight 1) out of the V(V-1)/2 possible ones, drawn with
+    // Floyd's algorithm, or with one sequential skip pass when E is more than half of them
+    static vector<Edge> sampleEdges(int V, long long E, uint32_t seed);
+
+    // Graph::forEdges(V, E) filled with E random edges (randomParallel() for Counter)
+    static Graph random(int V, long long E, uint32_t seed, EdgeSampling how = EdgeSampling::Floyd);
+
+    // Random graph built on threads threads (0 = one per hardware thread), the same one for
+    // every thread count. Draw i is output i of the splitmix64 stream of seed, computable on its
+    // own, and the edges are the first E distinct pairs the draws name (the complement of the
+    // first V(V-1)/2 - E when denser than half). Threads split the draws, find repeats in value
+    // buckets, then insert concurrently: atomic ORs into a BitMatrix when chooseStorage() picks a
+    // matrix, otherwise an atomic count and scatter into CSR rows.
+    static Graph randomParallel(int V, long long E, uint64_t seed, int threads = 0);
+
+    // Graph of a benchmark family; deterministic in the spec. Weighted or not, the edges are
+    // the same for a given spec; weights are drawn per edge afterwards. Built as CSR.
+    static Graph generate(const GeneratorSpec& spec);
+
+    // Read "<family> <V> <E> <S> [k=<clique size>] [w=<max weight>] [a=.. b=.. c=..]";
+    // false if the family is unknown, a value is out of range (E > V(V-1)/2, k > V, ...) or a
+    // token is not understood
+    static bool parseSpec(istream& in, GeneratorSpec& out);
+
+    // Most edges the graph of spec can have (E, plus the clique of PlantedClique, 2V for Grid)
+    static long long edgeBound(const GeneratorSpec& spec);
+
+    // Family for a name ("gnm", "rmat", "ba", "clique", "grid"); false if unknown
+    static bool parseFamily(const string& name, GraphFamily& out);
+    static const char* familyName(GraphFamily family);
+};
@@ -0,0 +1,79 @@
+// ===== graphImplicit.cpp =====
+#include "graphImplicit.h"
+#include <algorithm>
+using namespace std;
+
+ImplicitGraph::ImplicitGraph(int V, long long E, uint64_t seed, int maxWeight)
+    : V(max(V, 0)), seed(seed), maxWeight(maxWeight) {
+    pairs = this->V < 2 ? 0 : (uint64_t)this->V * (this->V - 1) / 2;
+    this->E = E <= 0 ? 0 : (long long)min<uint64_t>((uint64_t)E, pairs);
+    // Smallest even bit width covering the pair indices: cycle walking needs under 4 steps on average
+    half = 1;
+    while (half < 32 && (1ULL << (2 * half)) < pairs)
+        ++half;
+    mask = (1ULL << half) - 1;
+    for (int r = 0; r < 4; ++r)
+        keys[r] = GraphGenerator::counterDraw(seed, r);
+}
+
+uint64_t ImplicitGraph::encrypt(uint64_t x) const {
+    uint64_t l = x >> half, r = x & mask;
+    for (uint64_t k : keys) {
+        uint64_t f = GraphGenerator::counterDraw(k, r) & mask;
+        uint64_t next = l ^ f;
+        l = r;
+        r = next;
+    }
+    return (l << half) | r;
+}
+
+Edge ImplicitGraph::edge(long long i) const {
+    // Cycle walking: a permutation of [0, 4^half) restricted to [0, pairs) is one of [0, pairs)
+    uint64_t k = (uint64_t)i;
+    do
+        k = encrypt(k);
+    while (k >= pairs);
+    Edge e = GraphGenerator::pairAt(V, k);
+    if (maxWeight > 1)
+        e.w = 1 + (int)GraphGenerator::scaled(GraphGenerator::counterDraw(seed ^ 0x5DEECE66DULL, (uint64_t)i),
+                                              (uint64_t)maxWeight);
+    return e;
+}
+
+Graph ImplicitGraph::materialize() const {
+    vector<size_t> off(V + 1, 0);
+    forEachEdge([&](const Edge& e) {
+        off[e.u + 1]++;
+        off[e.v + 1]++;
+    });
+    for (int u = 0; u < V; ++u)
+        off[u + 1] += off[u];
+    vector<size_t> next(off.begin(), off.end() - 1);
+    vector<int> adj(off[V]);
+    vector<int32_t> w(weighted() ? off[V] : 0);
+    forEachEdge([&](const Edge& e) {
+        size_t p = next[e.u]++, q = next[e.v]++;
+        adj[p] = e.v;
+        adj[q] = e.u;
+        if (weighted())
+            w[p] = w[q] = e.w;
+    });
+    // Rows filled in edge order: sort each by neighbor, weights along
+    vector<pair<int, int32_t>> row;
+    for (int u = 0; u < V; ++u) {
+        size_t b = off[u], n = off[u + 1] - b;
+        if (!weighted()) {
+            sort(adj.begin() + b, adj.begin() + b + n);
+            continue;
+        }
+        row.resize(n);
+        for (size_t k = 0; k < n; ++k)
+            row[k] = {adj[b + k], w[b + k]};
+        sort(row.begin(), row.end());
+        for (size_t k = 0; k < n; ++k) {
+            adj[b + k] = row[k].first;
+            w[b + k] = row[k].second;
+        }
+    }
+    return Graph(CSRGraph<int32_t>(V, false, std::move(off), std::move(adj), std::move(w)));
+}
@@ -0,0 +1,54 @@
+// ===== graphImplicit.h =====
+#pragma once
+#include <cstdint>
+#include "graph.h"
+#include "graphGenerator.h"
+using namespace std;
+
+// Random simple undirected graph that exists only as (V, E, seed): edge i is recomputed on demand
+// as the pair with index pi(i), where pi is a pseudorandom permutation of the V(V-1)/2 pair
+// indices keyed by the seed (4-round Feistel network with cycle walking). Distinct i give
+// distinct pairs, so E edges need no memory and no duplicate check; streaming algorithms
+// (see algoStream) read them in O(1) each.
+class ImplicitGraph {
+    int V;
+    long long E;
+    uint64_t seed;
+    int maxWeight;      // above 1: weights in [1, maxWeight]
+    uint64_t pairs;     // V(V-1)/2
+    int half;           // bits of each Feistel half
+    uint64_t mask;      // (1 << half) - 1
+    uint64_t keys[4];   // round keys
+
+    // One pass of the Feistel network over [0, 4^half)
+    uint64_t encrypt(uint64_t x) const;
+
+public:
+    // E is clipped to V(V-1)/2
+    ImplicitGraph(int V, long long E, uint64_t seed, int maxWeight = 1);
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Number of edges
+    long long edgeCount() const { return E; }
+
+    // Always undirected
+    bool directed() const { return false; }
+
+    // Whether edges carry weights other than 1
+    bool weighted() const { return maxWeight > 1; }
+
+    // Edge i (u < v), for 0 <= i < edgeCount()
+    Edge edge(long long i) const;
+
+    // Call f(edge) for every edge, in index order
+    template <class F>
+    void forEachEdge(F f) const {
+        for (long long i = 0; i < E; ++i)
+            f(edge(i));
+    }
+
+    // Build the graph for the algorithms that need random access (CSR, O(E) memory)
+    Graph materialize() const;
+};
@@ -0,0 +1,122 @@
+// ===== graphLists.h =====
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "GraphTypes.h"
+using namespace std;
+
+// Adjacency lists with weights of type W, for sparse graphs: memory is O(V+E).
+// Every list is kept sorted so neighbors come out ascending and hasEdge() is a binary search.
+template <class W>
+class AdjacencyLists {
+    int V; // number of vertices
+    bool isDirected;
+    vector<vector<int>> adj; // sorted neighbor ids of each vertex
+    vector<vector<W>> wts;   // weights parallel to adj
+
+    // Insert or update v in the list of u
+    void put(int u, int v, W weight) {
+        auto& a = adj[u];
+        auto it = lower_bound(a.begin(), a.end(), v);
+        size_t p = it - a.begin();
+        if (it != a.end() && *it == v) {
+            wts[u][p] = weight;
+            return;
+        }
+        a.insert(it, v);
+        wts[u].insert(wts[u].begin() + p, weight);
+    }
+
+    // Erase v from the list of u
+    void drop(int u, int v) {
+        auto& a = adj[u];
+        auto it = lower_bound(a.begin(), a.end(), v);
+        if (it == a.end() || *it != v)
+            return;
+        wts[u].erase(wts[u].begin() + (it - a.begin()));
+        a.erase(it);
+    }
+
+    // Position of v in the list of u, or -1
+    long long find(int u, int v) const {
+        const auto& a = adj[u];
+        auto it = lower_bound(a.begin(), a.end(), v);
+        return (it == a.end() || *it != v) ? -1 : it - a.begin();
+    }
+
+public:
+    using weight_type = W;
+
+    // Walks one list and its weights together
+    class NeighborIterator {
+        const int* n;
+        const W* w;
+    public:
+        NeighborIterator(const int* n, const W* w) : n(n), w(w) {}
+        int operator*() const { return *n; }
+        W weight() const { return *w; }
+        NeighborIterator& operator++() { ++n; ++w; return *this; }
+        bool operator!=(const NeighborIterator& o) const { return n != o.n; }
+    };
+
+    AdjacencyLists(int V = 0, bool isDirected = false) : V(V), isDirected(isDirected), adj(V), wts(V) {}
+
+    // Copy lists with another weight type (used when weights outgrow W)
+    template <class W2>
+    explicit AdjacencyLists(const AdjacencyLists<W2>& o) : AdjacencyLists(o.vertexCount(), o.directed()) {
+        for (int u = 0; u < V; ++u) {
+            auto r = o.neighbors(u);
+            for (auto it = r.begin(); it != r.end(); ++it) {
+                adj[u].push_back(*it);
+                wts[u].push_back(static_cast<W>(it.weight()));
+            }
+        }
+    }
+
+    // Set the weight of edge u-v (both lists if undirected)
+    void addEdge(int u, int v, W weight) {
+        put(u, v, weight);
+        if (!isDirected)
+            put(v, u, weight);
+    }
+
+    // Remove edge u-v
+    void removeEdge(int u, int v) {
+        drop(u, v);
+        if (!isDirected)
+            drop(v, u);
+    }
+
+    // Degree of a vertex, O(1)
+    int degree(int u) const { return (int)adj[u].size(); }
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Bytes held by the lists and their weights, O(V)
+    size_t byteCount() const {
+        size_t b = (adj.size() + wts.size()) * sizeof(vector<int>);
+        for (int u = 0; u < V; ++u)
+            b += adj[u].capacity() * sizeof(int) + wts[u].capacity() * sizeof(W);
+        return b;
+    }
+
+    // Check if the graph is directed
+    bool directed() const { return isDirected; }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return find(u, v) >= 0; }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    W weight(int u, int v) const {
+        long long p = find(u, v);
+        return p < 0 ? W(0) : wts[u][p];
+    }
+
+    // Neighbors of u in ascending order
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        const int* n = adj[u].data();
+        const W* w = wts[u].data();
+        return {NeighborIterator(n, w), NeighborIterator(n + adj[u].size(), w + adj[u].size())};
+    }
+};
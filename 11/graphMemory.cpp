@@ -0,0 +1,214 @@
+// ===== graphMemory.cpp =====
+#include "graphMemory.h"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+    mutex policyLock;
+    MemoryPolicy current;
+
+    const size_t LINE = 64;
+    const size_t HUGE_PAGE = 2u << 20;
+
+    // mbind(2) modes (linux/mempolicy.h)
+    const int MPOL_BIND_MODE = 2;
+    const int MPOL_INTERLEAVE_MODE = 3;
+
+    size_t roundUp(size_t n, size_t unit) { return (n + unit - 1) / unit * unit; }
+
+    // Mask of the online NUMA nodes, read from sysfs ("0-3,6"); node 0 alone if unavailable
+    unsigned long onlineNodes() {
+        ifstream in("/sys/devices/system/node/online");
+        string list;
+        if (!(in >> list))
+            return 1;
+        unsigned long mask = 0;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = list.find(',', pos);
+            string part = list.substr(pos, end == string::npos ? string::npos : end - pos);
+            int a = 0, b = 0;
+            if (sscanf(part.c_str(), "%d-%d", &a, &b) < 2)
+                b = a;
+            for (int n = a; n <= b && n < (int)(8 * sizeof(mask)); ++n)
+                mask |= 1UL << n;
+            if (end == string::npos)
+                break;
+            pos = end + 1;
+        }
+        return mask ? mask : 1;
+    }
+
+    // Set the NUMA policy of [p, p+len) before it is touched; 0 or the errno of mbind(2)
+    int bindRegion(void* p, size_t len, int mode, unsigned long mask) {
+#ifdef SYS_mbind
+        if (syscall(SYS_mbind, p, len, mode, &mask, 8 * sizeof(mask) + 1, 0) == 0)
+            return 0;
+        return errno;
+#else
+        (void)p; (void)len; (void)mode; (void)mask;
+        return ENOSYS;
+#endif
+    }
+
+    // Anonymous mapping of len bytes (a multiple of align) starting on an align boundary;
+    // the extra head and tail mapped to find one are unmapped again
+    void* mapAligned(size_t len, size_t align) {
+        const int prot = PROT_READ | PROT_WRITE, flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if (align <= (size_t)sysconf(_SC_PAGESIZE))
+            return mmap(nullptr, len, prot, flags, -1, 0);
+        void* raw = mmap(nullptr, len + align, prot, flags, -1, 0);
+        if (raw == MAP_FAILED)
+            return raw;
+        char* base = static_cast<char*>(raw);
+        char* p = reinterpret_cast<char*>(roundUp(reinterpret_cast<size_t>(base), align));
+        if (p > base)
+            munmap(base, p - base);
+        munmap(p + len, base + align - p);
+        return p;
+    }
+}
+
+void GraphMemory::setPolicy(const MemoryPolicy& p) {
+    lock_guard<mutex> lk(policyLock);
+    current = p;
+}
+
+MemoryPolicy GraphMemory::policy() {
+    lock_guard<mutex> lk(policyLock);
+    return current;
+}
+
+void* GraphMemory::allocate(size_t bytes, MemoryPlacement& where) {
+    MemoryPolicy pol = policy();
+    where = MemoryPlacement{};
+
+    // Small buffers, or no placement asked for: zeroed heap memory
+    if (bytes < pol.minBytes || (pol.huge == HugePages::None && pol.numa == NumaMode::Default)) {
+        size_t len = roundUp(bytes, LINE);
+        void* p = aligned_alloc(LINE, len);
+        if (!p)
+            throw bad_alloc();
+        memset(p, 0, len);
+        return p;
+    }
+
+    where.mapped = true;
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (pol.huge == HugePages::Explicit) {
+        where.length = roundUp(bytes, HUGE_PAGE);
+        p = mmap(nullptr, where.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+            where.hugeTLB = true;
+        else
+            where.error = errno; // pool empty or not configured: fall back to transparent pages
+    }
+#endif
+    if (p == MAP_FAILED) {
+        bool huge = pol.huge != HugePages::None;
+        where.length = roundUp(bytes, huge ? HUGE_PAGE : (size_t)sysconf(_SC_PAGESIZE));
+        p = mapAligned(where.length, huge ? HUGE_PAGE : LINE);
+        if (p == MAP_FAILED)
+            throw bad_alloc();
+#ifdef MADV_HUGEPAGE
+        if (huge) {
+            if (madvise(p, where.length, MADV_HUGEPAGE) == 0)
+                where.thpAdvised = true;
+            else
+                where.error = errno;
+        }
+#endif
+    }
+
+    if (pol.numa != NumaMode::Default) {
+        bool interleave = pol.numa == NumaMode::Interleave;
+        unsigned long mask = interleave ? onlineNodes() : 1UL << pol.node;
+        int err = bindRegion(p, where.length, interleave ? MPOL_INTERLEAVE_MODE : MPOL_BIND_MODE, mask);
+        if (err == 0) {
+            where.numa = pol.numa;
+            where.node = interleave ? -1 : pol.node;
+        } else
+            where.error = err;
+    }
+
+    return p;
+}
+
+void GraphMemory::release(void* p, const MemoryPlacement& where) {
+    if (!p)
+        return;
+    if (where.mapped)
+        munmap(p, where.length);
+    else
+        free(p);
+}
+
+string MemoryPlacement::describe() const {
+    if (!mapped)
+        return "heap";
+    string s = "mmap " + to_string(length >> 20) + " MiB";
+    if (hugeTLB)
+        s += ", explicit huge pages";
+    else if (thpAdvised)
+        s += ", transparent huge pages";
+    else
+        s += ", normal pages";
+    if (numa == NumaMode::Interleave)
+        s += ", interleaved over all nodes";
+    else if (numa == NumaMode::Bind)
+        s += ", bound to node " + to_string(node);
+    else
+        s += ", first-touch node";
+    if (error)
+        s += string(" (refused: ") + strerror(error) + ")";
+    return s;
+}
+
+bool GraphMemory::parseHugePages(const string& name, HugePages& out) {
+    if (name == "none") out = HugePages::None;
+    else if (name == "thp") out = HugePages::Transparent;
+    else if (name == "explicit") out = HugePages::Explicit;
+    else return false;
+    return true;
+}
+
+bool GraphMemory::configure(const string& huge, const string& numa) {
+    MemoryPolicy p = policy();
+    if (!huge.empty() && !parseHugePages(huge, p.huge)) {
+        cerr << "Error: unknown huge page mode '" << huge << "' (none|thp|explicit)" << endl;
+        return false;
+    }
+    if (!numa.empty() && !parseNuma(numa, p.numa, p.node)) {
+        cerr << "Error: unknown NUMA mode '" << numa << "' (default|interleave|bind:<node>)" << endl;
+        return false;
+    }
+    setPolicy(p);
+    return true;
+}
+
+bool GraphMemory::parseNuma(const string& name, NumaMode& out, int& node) {
+    if (name == "default") out = NumaMode::Default;
+    else if (name == "interleave") out = NumaMode::Interleave;
+    else if (name.compare(0, 5, "bind:") == 0 && name.size() > 5) {
+        char* end = nullptr;
+        long n = strtol(name.c_str() + 5, &end, 10);
+        if (*end != '\0' || n < 0 || n >= (long)(8 * sizeof(unsigned long)))
+            return false;
+        out = NumaMode::Bind;
+        node = (int)n;
+    }
+    else return false;
+    return true;
+}
@@ -0,0 +1,65 @@
+// ===== graphMemory.h =====
+#pragma once
+#include <cstddef>
+#include <string>
+using namespace std;
+
+// Page size backing large graph buffers
+enum class HugePages {
+    None,        // normal pages
+    Transparent, // 2 MiB aligned mapping advised with MADV_HUGEPAGE (the kernel may or may not comply)
+    Explicit     // MAP_HUGETLB from the reserved pool, falling back to Transparent when none is free
+};
+
+// NUMA placement of large graph buffers
+enum class NumaMode {
+    Default,    // first touch: pages land on the node of the thread that writes them first
+    Interleave, // pages spread round-robin over all online nodes
+    Bind        // pages only on MemoryPolicy::node
+};
+
+// How GraphMemory places buffers of at least minBytes (smaller ones always come from the heap)
+struct MemoryPolicy {
+    HugePages huge = HugePages::None;
+    NumaMode numa = NumaMode::Default;
+    int node = 0;                   // node for NumaMode::Bind
+    size_t minBytes = 2u << 20;     // smallest buffer that gets its own mapping
+};
+
+// What an allocation actually got
+struct MemoryPlacement {
+    bool mapped = false;      // own mmap() region (else heap)
+    bool hugeTLB = false;     // backed by explicit huge pages
+    bool thpAdvised = false;  // MADV_HUGEPAGE accepted on the region
+    NumaMode numa = NumaMode::Default; // policy in force on the region
+    int node = -1;            // bound node (NumaMode::Bind)
+    int error = 0;            // errno of the huge page or NUMA request that was refused (0 = none)
+    size_t length = 0;        // bytes mapped
+
+    // e.g. "mmap 64 MiB, transparent huge pages, interleaved"
+    string describe() const;
+};
+
+// Allocation hook of the matrix storages (DenseMatrix, TriangularMatrix, BitMatrix): zeroed,
+// cache-line aligned buffers placed according to a process-wide policy. Large buffers get
+// their own anonymous mapping, which the kernel hands out already zeroed.
+class GraphMemory {
+public:
+    // Replace the policy used by later allocations
+    static void setPolicy(const MemoryPolicy& p);
+    static MemoryPolicy policy();
+
+    // Zeroed bytes aligned to 64; where receives how they were placed. Throws bad_alloc.
+    static void* allocate(size_t bytes, MemoryPlacement& where);
+
+    // Give back a buffer from allocate()
+    static void release(void* p, const MemoryPlacement& where);
+
+    // Parse "none" / "thp" / "explicit" and "default" / "interleave" / "bind:<node>"; false if unknown
+    static bool parseHugePages(const string& name, HugePages& out);
+    static bool parseNuma(const string& name, NumaMode& out, int& node);
+
+    // Set the policy from --huge / --numa values (empty keeps the current setting);
+    // prints an error and returns false on an unknown value
+    static bool configure(const string& huge, const string& numa);
+};
@@ -0,0 +1,389 @@
+// ===== graphParse.cpp =====
+#include "graphParse.h"
+#include "graphThreads.h"
+#include <iostream>
+#include <sstream>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+    // Part of the text handled by one thread, always whole lines
+    struct Chunk
+    {
+        const char* b;
+        const char* e;
+    };
+
+    // Per-thread results of one pass
+    struct PassResult
+    {
+        const char* bad = nullptr; // start of the first malformed line
+        long long edges = 0;
+        long long skipped = 0;
+        long long maxId = -1;
+        bool badWeight = false;    // a weight of 0 or NaN, or one the target storage cannot hold
+    };
+
+    // Split text into at most n chunks ending at line boundaries
+    vector<Chunk> split(const char* text, size_t len, int n)
+    {
+        vector<Chunk> out;
+        const char* end = text + len;
+        const char* p = text;
+        for (int i = 1; i <= n && p < end; ++i)
+        {
+            const char* q = i == n ? end : max(p, text + len / n * i);
+            if (q < end)
+            {
+                const char* nl = static_cast<const char*>(memchr(q, '\n', end - q));
+                q = nl ? nl + 1 : end;
+            }
+            out.push_back({p, q});
+            p = q;
+        }
+        return out;
+    }
+
+    // Skip spaces, tabs and carriage returns
+    inline const char* skipBlank(const char* p, const char* e)
+    {
+        while (p < e && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        return p;
+    }
+
+    // Call f(u, v, w) for every edge line of c. Returns the start of the first malformed line,
+    // or nullptr if there is none.
+    template <class F>
+    const char* scan(Chunk c, F&& f)
+    {
+        const char* p = c.b;
+        const char* e = c.e;
+        while (p < e)
+        {
+            const char* line = p;
+            p = skipBlank(p, e);
+            if (p == e)
+                break;
+            if (*p == '\n')
+            {
+                ++p;
+                continue;
+            }
+            if (*p == '#' || *p == '%')
+            {
+                const char* nl = static_cast<const char*>(memchr(p, '\n', e - p));
+                p = nl ? nl + 1 : e;
+                continue;
+            }
+            long long u, v;
+            double w = 1;
+            auto r = from_chars(p, e, u);
+            if (r.ec != errc())
+                return line;
+            p = skipBlank(r.ptr, e);
+            r = from_chars(p, e, v);
+            if (r.ec != errc())
+                return line;
+            p = skipBlank(r.ptr, e);
+            if (p < e && *p != '\n')
+            {
+                // Integer weights take the fast integer path; others are parsed as double
+                long long iw;
+                auto rw = from_chars(p, e, iw);
+                if (rw.ec == errc() && (rw.ptr == e || (*rw.ptr != '.' && *rw.ptr != 'e' && *rw.ptr != 'E')))
+                    w = (double)iw;
+                else
+                    rw = from_chars(p, e, w);
+                if (rw.ec != errc())
+                    return line;
+                p = skipBlank(rw.ptr, e);
+            }
+            if (p < e && *p != '\n')
+                return line;
+            if (p < e)
+                ++p;
+            if (u < 0 || v < 0)
+                return line;
+            f(u, v, w);
+        }
+        return nullptr;
+    }
+
+    // Run one scan per chunk in parallel; f(result, u, v, w) sees its own thread's result
+    template <class F>
+    vector<PassResult> pass(const vector<Chunk>& chunks, F f)
+    {
+        vector<PassResult> res(chunks.size());
+        runThreads((int)chunks.size(), [&](int t) {
+            PassResult& r = res[t];
+            r.bad = scan(chunks[t], [&](long long u, long long v, double w) { f(r, u, v, w); });
+        });
+        return res;
+    }
+
+    // Report the first malformed line (or unfit weight) of a pass; true if there was none
+    bool passOk(const vector<PassResult>& res, const char* text)
+    {
+        for (const auto& r : res)
+        {
+            if (r.bad)
+            {
+                cerr << "Error: Malformed edge line at byte " << (r.bad - text) << "." << endl;
+                return false;
+            }
+            if (r.badWeight)
+            {
+                cerr << "Error: Edge weight is 0 or does not fit the chosen storage." << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Check if weight is stored exactly by cell type W
+    template <class W>
+    bool fits(double w)
+    {
+        if (is_floating_point<W>::value)
+            return true;
+        return w == floor(w) && w >= (double)numeric_limits<W>::min() && w <= (double)numeric_limits<W>::max();
+    }
+
+    // Add up the per-thread counters into stats
+    void tally(const vector<PassResult>& res, ParseStats& st)
+    {
+        for (const auto& r : res)
+        {
+            st.edges += r.edges;
+            st.skipped += r.skipped;
+        }
+    }
+
+    // Count, scatter, then sort and merge every row of a CSR with weights of type W
+    template <class W>
+    bool buildCSR(const vector<Chunk>& chunks, const char* text, int V, bool directed, ParseStats& st, Graph& out)
+    {
+        int T = (int)chunks.size();
+        auto valid = [V](long long u, long long v) { return u != v && u < V && v < V; };
+
+        // Pass 1: entries per row
+        unique_ptr<atomic<size_t>[]> cnt(new atomic<size_t>[V + 1]());
+        auto res = pass(chunks, [&](PassResult& r, long long u, long long v, double w) {
+            if (!valid(u, v))
+            {
+                r.skipped++;
+                return;
+            }
+            if (!(w < 0 || w > 0) || !fits<W>(w))
+                r.badWeight = true;
+            r.edges++;
+            cnt[u + 1].fetch_add(1, memory_order_relaxed);
+            if (!directed)
+                cnt[v + 1].fetch_add(1, memory_order_relaxed);
+        });
+        if (!passOk(res, text))
+            return false;
+        tally(res, st);
+        vector<size_t> off(V + 1, 0);
+        for (int u = 0; u < V; ++u)
+            off[u + 1] = off[u] + cnt[u + 1].load(memory_order_relaxed);
+        for (int u = 0; u < V; ++u)
+            cnt[u].store(off[u], memory_order_relaxed); // now the next free slot of each row
+
+        // Pass 2: scatter every edge into its row(s)
+        vector<int> adj(off[V]);
+        vector<W> wts(off[V]);
+        pass(chunks, [&](PassResult&, long long u, long long v, double w) {
+            if (!valid(u, v))
+                return;
+            size_t p = cnt[u].fetch_add(1, memory_order_relaxed);
+            adj[p] = (int)v;
+            wts[p] = static_cast<W>(w);
+            if (!directed)
+            {
+                p = cnt[v].fetch_add(1, memory_order_relaxed);
+                adj[p] = (int)u;
+                wts[p] = static_cast<W>(w);
+            }
+        });
+        cnt.reset();
+
+        // Sort each row and merge repeated neighbors (largest weight wins, whatever the scatter order)
+        vector<size_t> len(V);
+        runThreads(T, [&](int t) {
+            vector<pair<int, W>> row;
+            for (int u = (int)((long long)V * t / T); u < (int)((long long)V * (t + 1) / T); ++u)
+            {
+                size_t b = off[u], e = off[u + 1];
+                row.clear();
+                for (size_t k = b; k < e; ++k)
+                    row.push_back({adj[k], wts[k]});
+                sort(row.begin(), row.end());
+                size_t n = 0;
+                for (size_t k = 0; k < row.size(); ++k)
+                {
+                    if (k + 1 < row.size() && row[k + 1].first == row[k].first)
+                        continue; // sorted by weight too, so the last of a run is the largest
+                    adj[b + n] = row[k].first;
+                    wts[b + n] = row[k].second;
+                    ++n;
+                }
+                len[u] = n;
+            }
+        });
+
+        // Close the gaps the merged duplicates left
+        vector<size_t> fin(V + 1, 0);
+        for (int u = 0; u < V; ++u)
+            fin[u + 1] = fin[u] + len[u];
+        if (fin[V] != off[V])
+        {
+            // Rows only move left (fin[u] <= off[u]); a row that stays put is skipped, since copy()
+            // may not start its output inside its input
+            for (int u = 1; u < V; ++u)
+            {
+                if (fin[u] == off[u])
+                    continue;
+                copy(adj.begin() + off[u], adj.begin() + off[u] + len[u], adj.begin() + fin[u]);
+                copy(wts.begin() + off[u], wts.begin() + off[u] + len[u], wts.begin() + fin[u]);
+            }
+            adj.resize(fin[V]);
+            wts.resize(fin[V]);
+        }
+        out = Graph(CSRGraph<W>(V, directed, std::move(fin), std::move(adj), std::move(wts)));
+        return true;
+    }
+
+    // Set the bits of every edge from all threads at once
+    bool buildBits(const vector<Chunk>& chunks, const char* text, int V, bool directed, ParseStats& st, Graph& out)
+    {
+        BitMatrix bits(V, directed);
+        auto res = pass(chunks, [&](PassResult& r, long long u, long long v, double w) {
+            if (u == v || u >= V || v >= V)
+            {
+                r.skipped++;
+                return;
+            }
+            if (w != 1)
+            {
+                r.badWeight = true;
+                return;
+            }
+            r.edges++;
+            bits.addEdgeAtomic((int)u, (int)v);
+        });
+        if (!passOk(res, text))
+            return false;
+        tally(res, st);
+        out = Graph(std::move(bits));
+        return true;
+    }
+}
+
+bool EdgeListReader::parse(const char* text, size_t len, Graph& out, const ParseOptions& opt, ParseStats* stats)
+{
+    auto t0 = chrono::steady_clock::now();
+    int T = threadBudget(opt.threads);
+    vector<Chunk> chunks = split(text, len, T);
+    ParseStats st;
+    st.bytes = len;
+    st.threads = (int)chunks.size();
+
+    // Without a vertex count, one pass finds the largest id
+    long long V = opt.vertices;
+    if (V < 0)
+    {
+        auto res = pass(chunks, [](PassResult& r, long long u, long long v, double) {
+            r.maxId = max(r.maxId, max(u, v));
+        });
+        if (!passOk(res, text))
+            return false;
+        for (const auto& r : res)
+            V = max(V, r.maxId + 1);
+        V = max(V, 0LL);
+        if (V > numeric_limits<int>::max())
+        {
+            cerr << "Error: Vertex id too large." << endl;
+            return false;
+        }
+    }
+
+    bool ok;
+    if (opt.storage == GraphStorage::Bits)
+        ok = buildBits(chunks, text, (int)V, opt.directed, st, out);
+    else if (opt.storage != GraphStorage::CSR)
+    {
+        cerr << "Error: The edge list reader builds CSR or Bits storage only." << endl;
+        return false;
+    }
+    else
+    {
+        switch (opt.weights)
+        {
+            case WeightType::U8:  ok = buildCSR<uint8_t>(chunks, text, (int)V, opt.directed, st, out); break;
+            case WeightType::U16: ok = buildCSR<uint16_t>(chunks, text, (int)V, opt.directed, st, out); break;
+            case WeightType::F32: ok = buildCSR<float>(chunks, text, (int)V, opt.directed, st, out); break;
+            default:              ok = buildCSR<int32_t>(chunks, text, (int)V, opt.directed, st, out); break;
+        }
+    }
+    st.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (ok && stats)
+        *stats = st;
+    return ok;
+}
+
+bool EdgeListReader::read(const string& path, Graph& out, const ParseOptions& opt, ParseStats* stats)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "Error: Cannot open " << path << "." << endl;
+        return false;
+    }
+    struct stat sb;
+    if (fstat(fd, &sb) != 0)
+    {
+        ::close(fd);
+        cerr << "Error: Cannot open " << path << "." << endl;
+        return false;
+    }
+    size_t len = sb.st_size;
+    if (len == 0)
+    {
+        ::close(fd);
+        return parse("", 0, out, opt, stats);
+    }
+    void* text = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (text == MAP_FAILED)
+    {
+        cerr << "Error: Cannot map " << path << "." << endl;
+        return false;
+    }
+    madvise(text, len, MADV_SEQUENTIAL);
+    bool ok = parse(static_cast<const char*>(text), len, out, opt, stats);
+    munmap(text, len);
+    return ok;
+}
+
+bool EdgeListReader::read(istream& in, Graph& out, const ParseOptions& opt, ParseStats* stats)
+{
+    ostringstream buf;
+    buf << in.rdbuf();
+    string text = buf.str();
+    return parse(text.data(), text.size(), out, opt, stats);
+}
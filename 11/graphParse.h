@@ -0,0 +1,46 @@
+// ===== graphParse.h =====
+#pragma once
+#include <string>
+#include <istream>
+#include "graph.h"
+using namespace std;
+
+// How EdgeListReader builds the graph
+struct ParseOptions {
+    int threads = 0;                          // parser threads (0 = one per hardware thread)
+    bool directed = false;
+    int vertices = -1;                        // vertex count; -1 = largest id + 1 (one extra pass)
+    GraphStorage storage = GraphStorage::CSR; // CSR, or Bits for unweighted graphs
+    WeightType weights = WeightType::I32;     // cell type of CSR weights
+};
+
+// What one parse did and how fast
+struct ParseStats {
+    size_t bytes = 0;      // size of the text
+    long long edges = 0;   // edge lines stored (before duplicates are merged)
+    long long skipped = 0; // self-loops and, with a given vertex count, out-of-range edges
+    int threads = 0;       // threads used
+    double seconds = 0;    // wall time from text to finished storage
+
+    double mbPerSecond() const { return seconds > 0 ? bytes / seconds / 1e6 : 0; }
+};
+
+// Parallel reader of text edge lists: one edge per line, "u v" or "u v w" (missing weight = 1),
+// 0-based ids, lines starting with # or % are comments. The text is split into one chunk per
+// thread at line boundaries and each chunk is parsed with std::from_chars. The passes go
+// straight into the target storage: counts and an atomic scatter into CSR rows, or atomic
+// ORs into a bit matrix, so no edge list is ever materialized.
+// Repeated pairs are merged keeping the largest weight; self-loops are dropped. Weights must not
+// be 0 ("no edge" in Graph); negative ones need I32 or F32 cells.
+class EdgeListReader {
+public:
+    // Map the file at path and parse it
+    static bool read(const string& path, Graph& out, const ParseOptions& opt = {}, ParseStats* stats = nullptr);
+
+    // Read the whole stream and parse it
+    static bool read(istream& in, Graph& out, const ParseOptions& opt = {}, ParseStats* stats = nullptr);
+
+    // Parse len bytes of text. Returns false and prints the reason on cerr on malformed input.
+    static bool parse(const char* text, size_t len, Graph& out, const ParseOptions& opt = {},
+                      ParseStats* stats = nullptr);
+};
@@ -0,0 +1,151 @@
+// ===== graphReorder.cpp =====
+#include "graphReorder.h"
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+using namespace std;
+
+bool parseVertexOrder(const string& name, VertexOrder& out) {
+    string k = name;
+    transform(k.begin(), k.end(), k.begin(), ::tolower);
+    if (k == "none") out = VertexOrder::None;
+    else if (k == "degree") out = VertexOrder::Degree;
+    else if (k == "rcm") out = VertexOrder::RCM;
+    else if (k == "bfs") out = VertexOrder::BFS;
+    else return false;
+    return true;
+}
+
+const char* vertexOrderName(VertexOrder order) {
+    switch (order) {
+        case VertexOrder::Degree: return "degree";
+        case VertexOrder::RCM:    return "rcm";
+        case VertexOrder::BFS:    return "bfs";
+        default:                  return "none";
+    }
+}
+
+// Vertices in discovery order of a BFS started at every still unvisited vertex of starts.
+// With byDegree, the new neighbors of each vertex are queued lowest degree first (Cuthill-McKee).
+template <class G>
+static vector<int> bfsOrder(const G& m, const vector<int>& starts, const vector<int>& deg, bool byDegree) {
+    int n = m.vertexCount();
+    vector<int> seq;
+    seq.reserve(n);
+    vector<char> seen(n, 0);
+    for (int s : starts) {
+        if (seen[s])
+            continue;
+        seen[s] = 1;
+        size_t head = seq.size();
+        seq.push_back(s);
+        while (head < seq.size()) {
+            int u = seq[head++];
+            size_t first = seq.size();
+            for (int v : m.neighbors(u))
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    seq.push_back(v);
+                }
+            if (byDegree)
+                stable_sort(seq.begin() + first, seq.end(), [&](int a, int b) { return deg[a] < deg[b]; });
+        }
+    }
+    return seq;
+}
+
+Relabeling VertexReorder::order(const Graph& g, VertexOrder how) {
+    int n = g.vertexCount();
+    Relabeling r;
+    r.oldId.resize(n);
+    iota(r.oldId.begin(), r.oldId.end(), 0);
+    vector<int> deg(n);
+    for (int u = 0; u < n; ++u)
+        deg[u] = g.degree(u);
+
+    if (how == VertexOrder::Degree) {
+        stable_sort(r.oldId.begin(), r.oldId.end(), [&](int a, int b) { return deg[a] > deg[b]; });
+    } else if (how == VertexOrder::BFS) {
+        vector<int> starts = r.oldId;
+        r.oldId = g.visit([&](const auto& m) { return bfsOrder(m, starts, deg, false); });
+    } else if (how == VertexOrder::RCM) {
+        // Each component starts from its lowest degree vertex; the whole sequence is reversed
+        vector<int> starts = r.oldId;
+        stable_sort(starts.begin(), starts.end(), [&](int a, int b) { return deg[a] < deg[b]; });
+        r.oldId = g.visit([&](const auto& m) { return bfsOrder(m, starts, deg, true); });
+        reverse(r.oldId.begin(), r.oldId.end());
+    }
+
+    r.newId.resize(n);
+    for (int v = 0; v < n; ++v)
+        r.newId[r.oldId[v]] = v;
+    return r;
+}
+
+// Relabeled CSR of m: new row v is the old row oldId[v] with renamed, re-sorted neighbors
+template <class M>
+static Graph relabelRows(const M& m, const Relabeling& r) {
+    using W = typename M::weight_type;
+    int n = m.vertexCount();
+    vector<size_t> off(n + 1, 0);
+    for (int v = 0; v < n; ++v)
+        off[v + 1] = off[v] + m.degree(r.oldId[v]);
+    vector<int> adj(off[n]);
+    vector<W> w(off[n]);
+    bool unit = true;
+    vector<pair<int, W>> row;
+    for (int v = 0; v < n; ++v) {
+        row.clear();
+        auto range = m.neighbors(r.oldId[v]);
+        for (auto it = range.begin(); it != range.end(); ++it) {
+            row.emplace_back(r.newId[*it], static_cast<W>(it.weight()));
+            unit = unit && row.back().second == W(1);
+        }
+        sort(row.begin(), row.end(), [](const pair<int, W>& a, const pair<int, W>& b) { return a.first < b.first; });
+        for (size_t k = 0; k < row.size(); ++k) {
+            adj[off[v] + k] = row[k].first;
+            w[off[v] + k] = row[k].second;
+        }
+    }
+    if (unit)
+        vector<W>().swap(w); // release the buffer too: an unweighted CSR has no weight array
+    return Graph(CSRGraph<W>(n, m.directed(), std::move(off), std::move(adj), std::move(w)));
+}
+
+Graph VertexReorder::apply(const Graph& g, const Relabeling& r) {
+    int n = g.vertexCount();
+    bool directed = g.directed();
+    GraphStorage kind = g.storage();
+    return g.visit([&](const auto& m) -> Graph {
+        using M = decay_t<decltype(m)>;
+        if constexpr (is_same<M, BitMatrix>::value) {
+            BitMatrix bits(n, directed);
+            for (int u = 0; u < n; ++u)
+                for (int v : m.neighbors(u))
+                    bits.addEdge(r.newId[u], r.newId[v]);
+            return Graph(std::move(bits));
+        } else if constexpr (is_same<M, DenseMatrix<typename M::weight_type>>::value ||
+                             IsTriangular<M>::value) {
+            Graph h(n, directed, kind, g.weightType());
+            for (int u = 0; u < n; ++u) {
+                auto range = m.neighbors(u);
+                for (auto it = range.begin(); it != range.end(); ++it)
+                    if (directed || *it > u)
+                        h.addEdge(r.newId[u], r.newId[*it], (double)it.weight());
+            }
+            return h;
+        } else {
+            Graph h = relabelRows(m, r);
+            if (kind == GraphStorage::Compressed)
+                h.convertTo(GraphStorage::Compressed);
+            return h;
+        }
+    });
+}
+
+ReorderedGraph::ReorderedGraph(const Graph& g, VertexOrder how) : source(&g) {
+    if (how == VertexOrder::None)
+        return;
+    map = VertexReorder::order(g, how);
+    relabeled = make_unique<Graph>(VertexReorder::apply(g, map));
+}
@@ -0,0 +1,78 @@
+// ===== graphReorder.h =====
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include "graph.h"
+using namespace std;
+
+// Vertex orders that place vertices used together next to each other in memory
+enum class VertexOrder {
+    None,   // keep the ids
+    Degree, // descending degree: the dense core (where clique search spends its time) comes first
+    RCM,    // reverse Cuthill-McKee: small bandwidth, neighbors get nearby ids
+    BFS     // breadth-first discovery order from the lowest id of each component
+};
+
+// Order for a name ("none", "degree", "rcm", "bfs", any case); false if unknown
+bool parseVertexOrder(const string& name, VertexOrder& out);
+
+// Name of an order, as parseVertexOrder() accepts it
+const char* vertexOrderName(VertexOrder order);
+
+// A permutation of the vertex ids: newId[old] and its inverse oldId[new]
+struct Relabeling {
+    vector<int> newId;
+    vector<int> oldId;
+};
+
+// Computes vertex orders and relabels graphs with them.
+// Directed graphs are ordered by their out-edges.
+class VertexReorder {
+public:
+    // Permutation putting the vertices of g in the given order
+    static Relabeling order(const Graph& g, VertexOrder how);
+
+    // Copy of g with vertex v renamed r.newId[v]. Matrix, Triangular and Bits graphs keep their
+    // storage; the others become CSR (Compressed stays Compressed), which every algorithm reads fastest.
+    static Graph apply(const Graph& g, const Relabeling& r);
+};
+
+// The graph an algorithm should run on: g itself for VertexOrder::None, otherwise a relabeled
+// copy. Vertex ids in results are translated back with original() / toOriginal().
+class ReorderedGraph {
+    const Graph* source;
+    unique_ptr<Graph> relabeled;
+    Relabeling map;
+
+public:
+    ReorderedGraph(const Graph& g, VertexOrder how);
+
+    // Graph to run on
+    const Graph& graph() const { return relabeled ? *relabeled : *source; }
+
+    // Whether the ids of graph() differ from the original ones
+    bool reordered() const { return relabeled != nullptr; }
+
+    // Original id of vertex v of graph()
+    int original(int v) const { return relabeled ? map.oldId[v] : v; }
+
+    // Vertex ids of graph() translated to original ids
+    vector<int> toOriginal(vector<int> ids) const {
+        if (relabeled)
+            for (int& v : ids)
+                v = map.oldId[v];
+        return ids;
+    }
+
+    // Per-vertex values of graph() re-indexed by original id
+    template <class T>
+    vector<T> perOriginal(const vector<T>& byNew) const {
+        if (!relabeled)
+            return byNew;
+        vector<T> out(byNew.size());
+        for (size_t v = 0; v < byNew.size(); ++v)
+            out[map.oldId[v]] = byNew[v];
+        return out;
+    }
+};
@@ -0,0 +1,29 @@
+// ===== graphShared.h =====
+#pragma once
+#include <memory>
+#include "graph.h"
+using namespace std;
+
+// Reference-counted immutable Graph. Copies are cheap and share one materialized graph, so
+// pipeline stages, requests and caches can hold the same graph at once. edit() is copy-on-write:
+// a shared graph is cloned first, so holders of other copies never see the change.
+class SharedGraph {
+    shared_ptr<Graph> g;
+
+public:
+    SharedGraph(Graph graph) : g(make_shared<Graph>(std::move(graph))) {}
+
+    // Read access
+    const Graph& operator*() const { return *g; }
+    const Graph* operator->() const { return g.get(); }
+
+    // Write access, cloning the graph if another copy still refers to it
+    Graph& edit() {
+        if (g.use_count() > 1)
+            g = make_shared<Graph>(*g);
+        return *g;
+    }
+
+    // Number of copies sharing this graph
+    long owners() const { return g.use_count(); }
+};
@@ -0,0 +1,31 @@
+// ===== graphThreads.h =====
+#pragma once
+#include <cstdint>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Run f(i) for every i in [0, n), each on its own thread (i = 0 on the calling one)
+template <class F>
+void runThreads(int n, F f) {
+    vector<thread> pool;
+    for (int i = 1; i < n; ++i)
+        pool.emplace_back(f, i);
+    if (n > 0)
+        f(0);
+    for (auto& t : pool)
+        t.join();
+}
+
+// Start of part t of [0, n) split into T parts
+inline uint64_t share(uint64_t n, int t, int T) {
+    return (uint64_t)((unsigned __int128)n * t / T);
+}
+
+// Thread count for a budget: threads if positive, otherwise one per hardware thread
+inline int threadBudget(int threads) {
+    if (threads > 0)
+        return threads;
+    unsigned hw = thread::hardware_concurrency();
+    return hw ? (int)hw : 1;
+}
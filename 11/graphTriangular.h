@@ -0,0 +1,140 @@
+// ===== graphTriangular.h =====
+#pragma once
+#include <cstring>
+#include <algorithm>
+#include "AlignedBuffer.h"
+#include "GraphTypes.h"
+using namespace std;
+
+// Weighted adjacency matrix of an undirected graph keeping only the cells above the diagonal:
+// the pairs (i, j) with i < j, packed row after row (row i holds V-1-i cells). Half the memory
+// of DenseMatrix, and half the cells to clear when it is built. The accessors take u and v in
+// either order, so algorithms see the same symmetric graph a full matrix gives them.
+// Row u is split in two: its cells right of the diagonal are contiguous, the ones left of it
+// are column u of the rows above (one cell per row, a shrinking stride apart); row() gathers
+// both into a plain array for scans that want the whole row at once.
+template <class W>
+class TriangularMatrix {
+    int V; // number of vertices
+    AlignedBuffer<W> cells; // V*(V-1)/2 cells
+
+    // Packed index of the first cell of row i, i.e. of pair (i, i+1)
+    size_t base(int i) const { return (size_t)i * (2 * (size_t)V - i - 1) / 2; }
+
+    // Packed index of pair {u, v}, u != v
+    size_t at(int u, int v) const {
+        if (u > v)
+            swap(u, v);
+        return base(u) + (v - u - 1);
+    }
+
+public:
+    using weight_type = W;
+
+    // Walks column u of the rows above, then row u right of the diagonal, skipping empty cells
+    class NeighborIterator {
+        const W* c;
+        int V, u, j;
+        size_t k; // packed index of pair {u, j}
+        void advance() {
+            ++j;
+            if (j < u)
+                k += V - j - 1; // next row of column u
+            else if (j == u) {
+                ++j;            // step over the diagonal to cell (u, u+1)
+                k = (size_t)u * (2 * (size_t)V - u - 1) / 2;
+            } else
+                ++k;
+        }
+        void skip() { while (j < V && c[k] == 0) advance(); }
+    public:
+        NeighborIterator(const W* c, int V, int u, int j) : c(c), V(V), u(u), j(j), k(0) {
+            if (j == 0) {
+                if (u == 0)
+                    this->j = 1; // row 0 has no column part
+                else
+                    k = u - 1;   // pair (0, u)
+                skip();
+            }
+        }
+        int operator*() const { return j; }
+        W weight() const { return c[k]; }
+        NeighborIterator& operator++() { advance(); skip(); return *this; }
+        bool operator!=(const NeighborIterator& o) const { return j != o.j; }
+    };
+
+    // isDirected must be false; it is taken so every storage is built the same way
+    TriangularMatrix(int V = 0, bool isDirected = false)
+        : V(V), cells(V > 1 ? (size_t)V * (V - 1) / 2 : 0) { (void)isDirected; }
+
+    // Copy a matrix with another cell type (used when weights outgrow W)
+    template <class W2>
+    explicit TriangularMatrix(const TriangularMatrix<W2>& o) : TriangularMatrix(o.vertexCount()) {
+        const W2* src = o.data();
+        W* dst = cells.data();
+        for (size_t k = 0; k < o.cellCount(); ++k)
+            dst[k] = static_cast<W>(src[k]);
+    }
+
+    // Set the weight of edge u-v
+    void addEdge(int u, int v, W weight) { cells.data()[at(u, v)] = weight; }
+
+    // Clear edge u-v
+    void removeEdge(int u, int v) { addEdge(u, v, 0); }
+
+    // Degree of a vertex (scans column u and row u)
+    int degree(int u) const {
+        auto r = neighbors(u);
+        int deg = 0;
+        for (auto it = r.begin(); it != r.end(); ++it)
+            ++deg;
+        return deg;
+    }
+
+    // Get number of vertices
+    int vertexCount() const { return V; }
+
+    // Always undirected
+    bool directed() const { return false; }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return u != v && cells.data()[at(u, v)] != 0; }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    W weight(int u, int v) const { return u == v ? W(0) : cells.data()[at(u, v)]; }
+
+    // Gather row u (V cells, diagonal included as 0) into out and return it
+    RowSpan<W> row(int u, W* out) const {
+        const W* c = cells.data();
+        size_t k = u - 1; // pair (0, u)
+        for (int j = 0; j < u; ++j) {
+            out[j] = c[k];
+            k += V - j - 2;
+        }
+        out[u] = 0;
+        if (u + 1 < V)
+            memcpy(out + u + 1, c + base(u), (size_t)(V - u - 1) * sizeof(W));
+        return {out, V};
+    }
+
+    // Neighbors of u in ascending order (scans column u and row u)
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        return {NeighborIterator(cells.data(), V, u, 0), NeighborIterator(cells.data(), V, u, V)};
+    }
+
+    // Where the cells were placed (see GraphMemory)
+    const MemoryPlacement& placement() const { return cells.placement(); }
+
+    // Packed cells, row after row
+    const W* data() const { return cells.data(); }
+    size_t cellCount() const { return cells.size(); }
+
+    // Bytes held by the cells
+    size_t byteCount() const { return cells.size() * sizeof(W); }
+};
+
+// True for TriangularMatrix<W> of any weight type
+template <class G>
+struct IsTriangular : false_type {};
+template <class W>
+struct IsTriangular<TriangularMatrix<W>> : true_type {};
@@ -0,0 +1,98 @@
+// ===== graphView.h =====
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "GraphTypes.h"
+using namespace std;
+
+// Subgraph of a typed storage G induced by a subset of its vertices, without copying any edge.
+// Vertex i of the view is the i-th smallest vertex of the subset; ids are translated while the
+// parent's rows are read, so every algorithm template runs on a component or a neighborhood as
+// if it were a graph of its own. Costs O(k) memory for k vertices; the parent must outlive it.
+template <class G>
+class GraphView {
+    const G* parent;
+    vector<int> ids; // parent id of each view vertex, ascending
+
+    using ParentIt = decltype(declval<const G&>().neighbors(0).first);
+
+public:
+    using weight_type = typename G::weight_type;
+
+    // Walks a parent row and keeps the neighbors inside the subset. Both are ascending, so the
+    // lookup position only moves forward through ids.
+    class NeighborIterator {
+        ParentIt it, last;
+        const int* pos; // first subset id not below the current parent neighbor
+        const int* first;
+        const int* end;
+        void settle() {
+            while (it != last) {
+                int p = *it;
+                pos = lower_bound(pos, end, p);
+                if (pos == end) {
+                    it = last; // no subset vertex left in this row
+                    return;
+                }
+                if (*pos == p)
+                    return;
+                ++it;
+            }
+        }
+    public:
+        NeighborIterator(ParentIt it, ParentIt last, const int* first, const int* end)
+            : it(it), last(last), pos(first), first(first), end(end) { settle(); }
+        int operator*() const { return (int)(pos - first); }
+        weight_type weight() const { return it.weight(); }
+        NeighborIterator& operator++() { ++it; settle(); return *this; }
+        bool operator!=(const NeighborIterator& o) const { return it != o.it; }
+    };
+
+    // View of g induced by vertices (parent ids; order and repeats do not matter)
+    GraphView(const G& g, vector<int> vertices) : parent(&g), ids(std::move(vertices)) {
+        sort(ids.begin(), ids.end());
+        ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    // Parent id of view vertex v
+    int parentId(int v) const { return ids[v]; }
+
+    // View id of parent vertex p, or -1 if it is not in the subset (binary search)
+    int localId(int p) const {
+        auto it = lower_bound(ids.begin(), ids.end(), p);
+        return it != ids.end() && *it == p ? (int)(it - ids.begin()) : -1;
+    }
+
+    // Parent ids of all view vertices, ascending
+    const vector<int>& vertices() const { return ids; }
+
+    // Get number of vertices
+    int vertexCount() const { return (int)ids.size(); }
+
+    // Check if the graph is directed
+    bool directed() const { return parent->directed(); }
+
+    // Degree inside the subset (reads the parent row)
+    int degree(int u) const {
+        auto r = neighbors(u);
+        int deg = 0;
+        for (auto it = r.begin(); it != r.end(); ++it)
+            ++deg;
+        return deg;
+    }
+
+    // Check if there is an edge u -> v
+    bool hasEdge(int u, int v) const { return parent->hasEdge(ids[u], ids[v]); }
+
+    // Weight of edge u -> v (0 if there is no edge)
+    weight_type weight(int u, int v) const { return parent->weight(ids[u], ids[v]); }
+
+    // Neighbors of u inside the subset, in ascending order
+    NeighborRange<NeighborIterator> neighbors(int u) const {
+        auto r = parent->neighbors(ids[u]);
+        const int* first = ids.data();
+        const int* end = first + ids.size();
+        return {NeighborIterator(r.first, r.last, first, end), NeighborIterator(r.last, r.last, first, end)};
+    }
+};
@@ -5,6 +5,12 @@
 #include <vector>
 // Include graph class header
 #include "graph.h"
+// Include binary graph file header
+#include "graphFile.h"
+// Include graph memory policy header
+#include "graphMemory.h"
+// Include parallel edge list reader
+#include "graphParse.h"
 // Include algorithm factory header
 #include "AlgorithmFactory.h"
 // Include algorithm strategy interface header
@@ -15,13 +21,21 @@ using namespace std;
 // Print usage instructions and exit
 static void usage(const char* prog) {
     cerr << "Usage:\n"
-         << "  " << prog << " --algo <MST|SCC|Cliques|MaxClique>\n"
+         << "  " << prog << " --algo <MST|SCC|Cliques|MaxClique|ParallelMST[:threads]>\n"
          << "  " << prog << " --all\n"
          << "Optional graph args:\n"
          << "  --undirected (default) | --directed\n"
          << "  --V <num_vertices>\n"
          << "  --E <num_edges>       (ignored if you build graph manually)\n"
-         << "\nNote: This demo builds a tiny fixed graph by code.\n";
+         << "  --graph <file.bin>    load a binary graph file (made by graph_convert) instead\n"
+         << "  --input <edges.txt>   parse a text edge list (\"u v [w]\" per line) instead\n"
+         << "  --threads <n>         parser threads for --input (default: all cores)\n"
+         << "  --bits                store an unweighted --input graph as a bit matrix\n"
+         << "  --compressed          run on gap/varint compressed rows (read-only, less memory)\n"
+         << "  --order <o>           relabel vertices first: none|degree|rcm|bfs (or per algorithm: --algo SCC@rcm)\n"
+         << "  --huge <none|thp|explicit>   huge pages for large matrix storages (default: none)\n"
+         << "  --numa <default|interleave|bind:N>   NUMA placement of large matrix storages\n"
+         << "\nNote: Without --graph or --input this demo builds a tiny fixed graph by code.\n";
     exit(1);
 }
 
@@ -54,6 +68,12 @@ int main(int argc, char** argv) {
     bool directed = false;
     bool runAll = false;
     string algoName;
+    string graphPath;
+    string inputPath;
+    bool compressed = false;
+    string order;
+    string huge, numa;
+    ParseOptions parseOpt;
 
     // Basic argument parsing loop
     for (int i=1; i<argc; ++i) {
@@ -66,16 +86,57 @@ int main(int argc, char** argv) {
         else if (a == "--all") runAll = true;
         // Set algorithm name if argument is --algo
         else if (a == "--algo" && i+1 < argc) { algoName = argv[++i]; }
+        // Load the graph from a file if argument is --graph
+        else if (a == "--graph" && i+1 < argc) { graphPath = argv[++i]; }
+        // Parse a text edge list if argument is --input
+        else if (a == "--input" && i+1 < argc) { inputPath = argv[++i]; }
+        // Set parser thread count if argument is --threads
+        else if (a == "--threads" && i+1 < argc) { parseOpt.threads = atoi(argv[++i]); }
+        // Build a bit matrix from the edge list if argument is --bits
+        else if (a == "--bits") parseOpt.storage = GraphStorage::Bits;
+        // Switch to compressed rows if argument is --compressed
+        else if (a == "--compressed") compressed = true;
+        // Set the vertex order of every algorithm if argument is --order
+        else if (a == "--order" && i+1 < argc) { order = argv[++i]; }
+        // Set the huge page mode of graph memory if argument is --huge
+        else if (a == "--huge" && i+1 < argc) { huge = argv[++i]; }
+        // Set the NUMA placement of graph memory if argument is --numa
+        else if (a == "--numa" && i+1 < argc) { numa = argv[++i]; }
     }
     // If no algorithm specified and not running all, show usage
     if (!runAll && algoName.empty()) usage(argv[0]);
+    // Apply the memory policy before any graph is allocated
+    if (!GraphMemory::configure(huge, numa)) return 1;
 
-    // Build the demo graph
+    // Build the demo graph, map the given graph file or parse the given edge list
     Graph g = build_demo_graph(directed);
+    if (!graphPath.empty() && !GraphFile::open(graphPath, g)) return 1;
+    if (!inputPath.empty()) {
+        parseOpt.directed = directed;
+        ParseStats st;
+        if (!EdgeListReader::read(inputPath, g, parseOpt, &st)) return 1;
+        cout << "Parsed " << st.bytes << " bytes (" << st.edges << " edges) with " << st.threads
+             << " threads in " << st.seconds << " s: " << st.mbPerSecond() << " MB/s\n";
+    }
+
+    // Re-encode the rows as gap/varint blocks and report the size against plain CSR
+    if (compressed) {
+        g.convertTo(GraphStorage::Compressed);
+        g.visit([](const auto& m) {
+            using M = decay_t<decltype(m)>;
+            if constexpr (IsCompressed<M>::value) {
+                size_t csr = m.entryCount() * (sizeof(int) + (m.weighted() ? sizeof(typename M::weight_type) : 0)) +
+                             (m.vertexCount() + 1) * sizeof(size_t);
+                cout << "Compressed rows: " << m.byteCount() << " bytes (CSR: " << csr << " bytes)\n";
+            }
+        });
+    }
 
-    // Print the graph
+    // Print the graph (only the size for a loaded one)
     cout << "Graph:\n";
-    g.printGraph();
+    if (graphPath.empty() && inputPath.empty()) g.printGraph();
+    else cout << g.vertexCount() << " vertices, " << g.edgeCount() << " edges\n";
+    if (!huge.empty() || !numa.empty()) cout << "Memory: " << g.placement().describe() << "\n";
     cout << "\n=== RESULTS ===\n";
 
     // Run all algorithms if runAll is true
@@ -83,12 +144,12 @@ int main(int argc, char** argv) {
         vector<string> names = {"MST", "SCC", "Num Of Cliques", "MaxClique"};
         for (const auto& n : names) {
             cout << "[" << n << "]\n";
-            cout << run_algo_by_name(n, g) << "\n\n";
+            cout << run_algo_by_name(order.empty() ? n : n + "@" + order, g) << "\n\n";
         }
     } else {
         // Run the selected algorithm
         cout << "[" << algoName << "]\n";
-        cout << run_algo_by_name(algoName, g) << "\n";
+        cout << run_algo_by_name(order.empty() || algoName.find('@') != string::npos ? algoName : algoName + "@" + order, g) << "\n";
     }
     // Return success
     return 0;
@@ -0,0 +1,120 @@
+// ===== mst_bench.cpp =====
+// Times Kruskal and Filter-Kruskal against array-based Prim and parallel Borůvka on random graphs
+// of growing density, and shows which one MSTMethod::Auto picks for each. With --updates, also
+// times DynamicMST against recomputing the MST after every single-edge change.
+#include <iostream>
+// Include random for the edge updates
+#include <random>
+// Include cstdio for printf
+#include <cstdio>
+// Include chrono for timing
+#include <chrono>
+// Include sstream to parse the density list
+#include <sstream>
+// Include string header for std::string
+#include <string>
+// Include vector header for std::vector
+#include <vector>
+// Include graph class header
+#include "graph.h"
+// Include the benchmark graph generator
+#include "graphGenerator.h"
+// Include the MST module
+#include "algoMST.h"
+// Include the incremental MST
+#include "graphDynamicMST.h"
+
+using namespace std;
+
+static void usage(const char* prog) {
+    cerr << "Usage: " << prog << " [--V n] [--density d1,d2,..] [--storage matrix|triangular|lists|csr] [--w max] [--seed s] [--threads t] [--updates k]\n"
+         << "  --V <n>          vertices (default 4000)\n"
+         << "  --density <list> edge densities E / (V(V-1)/2) to run (default 0.01,0.05,0.1,0.25,0.5,1)\n"
+         << "  --storage <s>    storage the algorithms read (default matrix)\n"
+         << "  --w <max>        weights uniform in [1, max] (default 255)\n"
+         << "  --threads <t>    Borůvka threads (default: all cores)\n"
+         << "  --updates <k>    also toggle k random vertex pairs per density, timing DynamicMST\n"
+         << "                   against a full recompute after each change (default 0: off)\n";
+    exit(1);
+}
+
+// Seconds taken by f()
+template <class F>
+static double seconds(F f) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    int V = 4000, maxWeight = 255, threads = 0, updates = 0;
+    uint64_t seed = 1;
+    string storage = "matrix", densities = "0.01,0.05,0.1,0.25,0.5,1";
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--V" && i+1 < argc) V = atoi(argv[++i]);
+        else if (a == "--density" && i+1 < argc) densities = argv[++i];
+        else if (a == "--storage" && i+1 < argc) storage = argv[++i];
+        else if (a == "--w" && i+1 < argc) maxWeight = atoi(argv[++i]);
+        else if (a == "--seed" && i+1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--threads" && i+1 < argc) threads = atoi(argv[++i]);
+        else if (a == "--updates" && i+1 < argc) updates = atoi(argv[++i]);
+        else usage(argv[0]);
+    }
+    GraphStorage kind;
+    if (storage == "matrix") kind = GraphStorage::Matrix;
+    else if (storage == "triangular") kind = GraphStorage::Triangular;
+    else if (storage == "lists") kind = GraphStorage::Lists;
+    else if (storage == "csr") kind = GraphStorage::CSR;
+    else usage(argv[0]);
+    if (V <= 1 || maxWeight < 2 || threads < 0 || updates < 0) usage(argv[0]);
+
+    printf("%d vertices, %s storage, weights 1..%d\n\n", V, storage.c_str(), maxWeight);
+    printf("density        edges  kruskal_s   filter_s     prim_s  speedup  boruvka_s  auto     MST\n");
+    istringstream list(densities);
+    string item;
+    while (getline(list, item, ',')) {
+        double d = atof(item.c_str());
+        GeneratorSpec spec;
+        spec.V = V;
+        spec.E = (long long)(d * V * (V - 1) / 2);
+        spec.seed = seed;
+        spec.maxWeight = maxWeight;
+        Graph g = GraphGenerator::generate(spec);
+        g.convertTo(kind);
+
+        long long kruskal = 0, filter = 0, prim = 0, boruvka = 0;
+        double tK = seconds([&] { kruskal = algoMST::mstWeight(g, MSTMethod::Kruskal); });
+        double tF = seconds([&] { filter = algoMST::mstWeight(g, MSTMethod::FilterKruskal); });
+        double tP = seconds([&] { prim = algoMST::mstWeight(g, MSTMethod::Prim); });
+        double tB = seconds([&] { boruvka = algoMST::mstWeight(g, MSTMethod::Boruvka, threads); });
+        bool auto_prim = algoMST::preferPrim(g.vertexCount(), g.edgeCount());
+        printf("%7.3f %12lld %10.4f %10.4f %10.4f %8.2f %10.4f  %-7s  %lld%s\n", d, g.edgeCount(), tK, tF, tP,
+               tP > 0 ? tF / tP : 0.0, tB, auto_prim ? "prim" : "kruskal", kruskal,
+               kruskal == filter && kruskal == prim && kruskal == boruvka ? "" : "  MISMATCH");
+        if (updates > 0) {
+            // Toggle random pairs: remove the edge if present, else add it with a random weight
+            DynamicMST dyn(g);
+            mt19937_64 rng(seed);
+            double tDyn = 0, tFull = 0;
+            bool same = true;
+            for (int k = 0; k < updates; ++k) {
+                int u = (int)(rng() % V), v = (int)(rng() % V), w = 1 + (int)(rng() % maxWeight);
+                if (u == v) continue;
+                bool present = g.hasEdge(u, v);
+                long long a = 0, b = 0;
+                tDyn += seconds([&] {
+                    if (present) dyn.removeEdge(u, v); else dyn.addEdge(u, v, w);
+                    a = dyn.mstWeight();
+                });
+                if (present) g.removeEdge(u, v); else g.addEdge(u, v, w);
+                tFull += seconds([&] { b = algoMST::mstWeight(g); });
+                same = same && a == b;
+            }
+            printf("        %d updates: dynamic %.2f us, recompute %.2f us per update%s\n", updates,
+                   1e6 * tDyn / updates, 1e6 * tFull / updates, same ? "" : "  MISMATCH");
+        }
+    }
+    return 0;
+}
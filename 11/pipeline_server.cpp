@@ -14,6 +14,9 @@
 #include <atomic>
 
 #include "graph.h"
+#include "graphFile.h"
+#include "graphMemory.h"
+#include "graphGenerator.h"
 #include "AlgorithmFactory.h"
 #include "AlgorithmStrategy.h"
 #include "Algorithms.h"
@@ -21,6 +24,7 @@
 #include "ThreadSafeQueue.h"
 #include "ActiveObject.h"
 #include "PipelineTypes.h"
+#include "ResultCache.h"
 
 #define PORT 8080
 using namespace std;
@@ -34,6 +38,9 @@ using namespace std;
 // Global request counter
 static std::atomic<unsigned long> GREQ{0};
 
+// Graphs and results of recent requests, shared by all stages
+static ResultCache g_cache;
+
 // Log function for pipeline stages
 static void log(const char* tag, unsigned long id, const char* msg){
     std::cout << "[" << tag << "][req " << id << "] " << msg << std::endl;
@@ -54,25 +61,29 @@ static string run_algo_by_name(const string& name, const Graph& g) {
 }
 
 // ===== Build random graph (simple, undirected, no self-loops) =====
+// Edge sampling: parallel counter-based (same graph for any core count), or with
+// --legacy-random the shuffle of all V(V-1)/2 pairs
+static EdgeSampling g_sampling = EdgeSampling::Counter;
+
+// Largest graph a random or GEN request may ask for (--max-vertices, --max-edges)
+static GraphBudget g_budget;
+
+// Directory LOAD requests may read graph files from (--graph-dir); LOAD is refused without one
+static string g_graph_dir;
+
 // Build a random undirected graph with V vertices and E edges using seed S
 static Graph build_random_graph(int V, int E, unsigned int S) {
-    mt19937 gen(S);
-    vector<pair<int,int>> all;
-    all.reserve((size_t)V*(V-1)/2);
-    for (int i=0;i<V;i++)
-        for (int j=i+1;j<V;j++)
-            all.push_back({i,j});
-    shuffle(all.begin(), all.end(), gen);
-    Graph g(V, false);
-    int added=0;
-    for (size_t i=0;i<all.size() && added<E; ++i) {
-        if (g.addEdge(all[i].first, all[i].second, 1)) added++;
-    }
-    return g;
+    return GraphGenerator::random(V, E, S, g_sampling);
+}
+
+// Random graph for V, E, S, shared with earlier requests for the same parameters
+static optional<SharedGraph> cached_random_graph(int V, int E, unsigned int S) {
+    string key = to_string(V) + " " + to_string(E) + " " + to_string(S);
+    return g_cache.graph(key, [&](Graph& out) { out = build_random_graph(V,E,S); return true; });
 }
 
 // Parse request string and build graph
-static bool parse_request_build_graph(const string& req, Graph& outG) {
+static optional<SharedGraph> parse_request_build_graph(const string& req) {
     if (req == "auto\n") {
         random_device rd;
         mt19937 gen(rd());
@@ -82,26 +93,43 @@ static bool parse_request_build_graph(const string& req, Graph& outG) {
         uniform_int_distribution<long long> dE(0, maxE);
         int E = (int)dE(gen);
         unsigned int S = (unsigned int)(E*V);
-        outG = build_random_graph(V,E,S);
-        return true;
+        return cached_random_graph(V,E,S);
+    } else if (req.compare(0, 5, "LOAD ") == 0) {
+        // "LOAD <name>\n": map a binary graph file of the --graph-dir directory, verified in full
+        // (the graph is not cached, the file may change; its results are, by the recomputed fingerprint)
+        istringstream iss(req.substr(5));
+        string name, path;
+        if (!(iss >> name) || !GraphFile::inDirectory(g_graph_dir, name, path)) return nullopt;
+        return g_cache.graph("", [&](Graph& out) { return GraphFile::open(path, out, true); });
+    } else if (req.compare(0, 4, "GEN ") == 0) {
+        // "GEN <family> <V> <E> <S> [options]\n": a benchmark graph family (see GraphGenerator)
+        istringstream iss(req.substr(4));
+        GeneratorSpec spec;
+        if (!GraphGenerator::parseSpec(iss, spec)) return nullopt;
+        if (!g_budget.allows(spec.V, GraphGenerator::edgeBound(spec))) return nullopt;
+        return g_cache.graph("GEN " + spec.str(), [&](Graph& out) { out = GraphGenerator::generate(spec); return true; });
     } else {
         // "<V> <E> <S> [A]\n"  (A is not used here)
         istringstream iss(req);
         int V,E; unsigned int S; string A;
-        if (!(iss >> V >> E >> S)) return false;
+        if (!(iss >> V >> E >> S)) return nullopt;
         long long maxEdges = 1LL*V*(V-1)/2;
-        if (E > maxEdges || V <= 0 || E < 0) return false;
-        outG = build_random_graph(V,E,S);
-        return true;
+        if (E > maxEdges || V <= 0 || E < 0 || !g_budget.allows(V, E)) return nullopt;
+        return cached_random_graph(V,E,S);
     }
 }
 
+// Run algorithm name on the request's graph, or reuse the output cached for an identical graph
+static string run_cached(const Request& r, const string& name) {
+    return g_cache.result(*r.g, name, [&] { return run_algo_by_name(name, *r.g); });
+}
+
 // ===== Pipeline stages =====
 // Stage 1: MST algorithm
 static void stage_mst(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO1-MST", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("MST", r.g);
+    r.result += run_cached(r, "MST");
     log("AO1-MST", r.req_id, "done -> next");
     if (out) out->push(std::move(r));
 }
@@ -110,7 +138,7 @@ static void stage_mst(Request&& r, ThreadSafeQueue<Request>* out) {
 static void stage_scc(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO2-SCC", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("SCC", r.g);
+    r.result += run_cached(r, "SCC");
     log("AO2-SCC", r.req_id, "done -> next");
     if (out) out->push(std::move(r));
 }
@@ -119,7 +147,7 @@ static void stage_scc(Request&& r, ThreadSafeQueue<Request>* out) {
 static void stage_countCliques(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO3-COUNT", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("NUMOFCLIQUES", r.g);
+    r.result += run_cached(r, "NUMOFCLIQUES");
     log("AO3-COUNT", r.req_id, "done -> next");
     if (out) out->push(std::move(r));
 }
@@ -128,7 +156,7 @@ static void stage_countCliques(Request&& r, ThreadSafeQueue<Request>* out) {
 static void stage_maxClique(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO4-MAX", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("MAXCLIQUE", r.g);
+    r.result += run_cached(r, "MAXCLIQUE");
     log("AO4-MAX", r.req_id, "done -> next");
     if (out) out->push(std::move(r));
 }
@@ -137,7 +165,7 @@ static void stage_maxClique(Request&& r, ThreadSafeQueue<Request>* out) {
 static void stage_hasEuler(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO5-HAS-EULER", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("HASEULERCIRCUIT", r.g);
+    r.result += run_cached(r, "HASEULERCIRCUIT");
     log("AO5-HAS-EULER", r.req_id, "done -> next");
     if (out) out->push(std::move(r));
 }
@@ -146,7 +174,7 @@ static void stage_hasEuler(Request&& r, ThreadSafeQueue<Request>* out) {
 static void stage_euler(Request&& r, ThreadSafeQueue<Request>* out) {
     log("AO6-EULER", r.req_id, "start");
     maybe_delay();
-    r.result += run_algo_by_name("EULERCIRCUIT", r.g);
+    r.result += run_cached(r, "EULERCIRCUIT");
     log("AO6-EULER", r.req_id, "done -> sink");
     if (out) out->push(std::move(r));
 }
@@ -160,7 +188,23 @@ static void stage_sink(Request&& r, ThreadSafeQueue<Request>* /*out*/) {
 }
 
 // ===== main: acceptor + wiring =====
-int main() {
+int main(int argc, char** argv) {
+    // Graph memory placement: --huge <none|thp|explicit>, --numa <default|interleave|bind:N>;
+    // --legacy-random: the random graphs of earlier versions for the same seeds;
+    // --max-vertices / --max-edges: the largest graph one request may build;
+    // --graph-dir: the directory LOAD requests read from (LOAD is refused without one)
+    std::string huge, numa;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--huge" && i + 1 < argc) huge = argv[++i];
+        else if (a == "--numa" && i + 1 < argc) numa = argv[++i];
+        else if (a == "--legacy-random") g_sampling = EdgeSampling::ShufflePairs;
+        else if (a == "--max-vertices" && i + 1 < argc) g_budget.maxVertices = atoll(argv[++i]);
+        else if (a == "--graph-dir" && i + 1 < argc) g_graph_dir = argv[++i];
+        else if (a == "--max-edges" && i + 1 < argc) g_budget.maxEdges = atoll(argv[++i]);
+    }
+    if (!GraphMemory::configure(huge, numa)) return 1;
+
     // Create server socket
     int srv = ::socket(AF_INET, SOCK_STREAM, 0);
     int opt=1;
@@ -200,20 +244,22 @@ int main() {
         buf[n] = '\0';
         std::string req = buf;
 
-        Graph g(1,false);
         unsigned long id = ++GREQ;
         log("ACCEPT", id, "new connection, parsing request");
 
-        // Parse request and build graph, handle errors
-        if (!parse_request_build_graph(req, g)) {
+        // Parse request and build (or reuse) the graph, handle errors
+        auto g = parse_request_build_graph(req);
+        if (!g) {
             std::string err = "Bad request or invalid edges count.\n";
             ::send(cfd, err.c_str(), err.size(), 0);
             ::close(cfd);
             log("ACCEPT", id, "bad request, closed");
             continue;
         }
+        if ((*g)->placement().mapped)
+            log("ACCEPT", id, ("graph memory: " + (*g)->placement().describe()).c_str());
         log("ACCEPT", id, "pushed to q1");
-        q1.push(Request{cfd, std::move(g), id});
+        q1.push(Request{cfd, std::move(*g), id});
     }
 
     // Stop and join all pipeline stages (unreachable in normal execution)
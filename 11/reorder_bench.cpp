@@ -0,0 +1,154 @@
+// ===== reorder_bench.cpp =====
+// Times the algorithms on one graph relabeled to every vertex order.
+// Run it under cachegrind (make bench-cache) to count the cache misses of each order.
+#include <iostream>
+// Include cstdio for printf
+#include <cstdio>
+// Include cmath for sqrt
+#include <cmath>
+// Include algorithm header for std::shuffle, std::max_element
+#include <algorithm>
+// Include memory header for smart pointers
+#include <memory>
+// Include chrono for timing
+#include <chrono>
+// Include random for the generators
+#include <random>
+// Include string header for std::string
+#include <string>
+// Include vector header for std::vector
+#include <vector>
+// Include graph class header
+#include "graph.h"
+// Include reorder header
+#include "graphReorder.h"
+// Include the algorithm modules
+#include "algoSCC.h"
+#include "algoCliques.h"
+#include "algoMST.h"
+
+using namespace std;
+
+static void usage(const char* prog) {
+    cerr << "Usage: " << prog << " [--V n] [--deg d] [--kind random|geometric] [--order o] [--seed s] [--cliques]\n"
+         << "  --V <n>         vertices (default 200000)\n"
+         << "  --deg <d>       average degree (default 8)\n"
+         << "  --kind <k>      random: uniform G(n,m); geometric: points joined to near points,\n"
+         << "                  ids shuffled so the locality is hidden (default geometric)\n"
+         << "  --order <o>     run only none|degree|rcm|bfs (default: all of them)\n"
+         << "  --cliques       also count maximal cliques (Bron-Kerbosch starts from all V vertices,\n"
+         << "                  so keep V in the thousands)\n";
+    exit(1);
+}
+
+// Uniform random graph: V*deg/2 edges between random endpoints, with random weights 1..100
+static vector<Edge> random_edges(int V, int deg, mt19937& rng) {
+    uniform_int_distribution<int> pick(0, V - 1), w(1, 100);
+    vector<Edge> e((size_t)V * deg / 2);
+    for (auto& x : e) x = Edge{pick(rng), pick(rng), w(rng)};
+    return e;
+}
+
+// Random geometric graph: V points in the unit square, each joined to the points within the
+// radius that gives about deg neighbors; vertex ids are a random permutation of the points
+static vector<Edge> geometric_edges(int V, int deg, mt19937& rng) {
+    uniform_real_distribution<double> coord(0, 1);
+    uniform_int_distribution<int> w(1, 100);
+    vector<double> x(V), y(V);
+    for (int i = 0; i < V; ++i) { x[i] = coord(rng); y[i] = coord(rng); }
+    vector<int> id(V);
+    for (int i = 0; i < V; ++i) id[i] = i;
+    shuffle(id.begin(), id.end(), rng);
+
+    // Bucket the points into cells of side r so only the 9 surrounding cells are compared
+    double r = sqrt(deg / (3.14159265 * V));
+    int cells = max(1, (int)(1 / r));
+    vector<vector<int>> grid((size_t)cells * cells);
+    auto cell = [&](double c) { return min(cells - 1, (int)(c * cells)); };
+    for (int i = 0; i < V; ++i) grid[(size_t)cell(x[i]) * cells + cell(y[i])].push_back(i);
+
+    vector<Edge> e;
+    for (int i = 0; i < V; ++i) {
+        int cx = cell(x[i]), cy = cell(y[i]);
+        for (int dx = -1; dx <= 1; ++dx)
+            for (int dy = -1; dy <= 1; ++dy) {
+                int gx = cx + dx, gy = cy + dy;
+                if (gx < 0 || gy < 0 || gx >= cells || gy >= cells) continue;
+                for (int j : grid[(size_t)gx * cells + gy])
+                    if (j > i && (x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j]) <= r * r)
+                        e.push_back(Edge{id[i], id[j], w(rng)});
+            }
+    }
+    return e;
+}
+
+// Mean |u - v| over all edges: how far apart in memory the endpoints of an edge are
+static double mean_span(const Graph& g) {
+    return g.visit([](const auto& m) {
+        double sum = 0;
+        size_t n = 0;
+        for (int u = 0; u < m.vertexCount(); ++u)
+            for (int v : m.neighbors(u)) { sum += abs(u - v); ++n; }
+        return n ? sum / n : 0.0;
+    });
+}
+
+// Seconds taken by f()
+template <class F>
+static double seconds(F f) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    int V = 200000, deg = 8;
+    unsigned seed = 1;
+    string kind = "geometric";
+    bool cliques = false;
+    vector<VertexOrder> orders = {VertexOrder::None, VertexOrder::Degree, VertexOrder::RCM, VertexOrder::BFS};
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--V" && i+1 < argc) V = atoi(argv[++i]);
+        else if (a == "--deg" && i+1 < argc) deg = atoi(argv[++i]);
+        else if (a == "--seed" && i+1 < argc) seed = (unsigned)atoi(argv[++i]);
+        else if (a == "--kind" && i+1 < argc) kind = argv[++i];
+        else if (a == "--cliques") cliques = true;
+        else if (a == "--order" && i+1 < argc) {
+            VertexOrder o;
+            if (!parseVertexOrder(argv[++i], o)) usage(argv[0]);
+            orders = {o};
+        }
+        else usage(argv[0]);
+    }
+    if (V <= 0 || deg <= 0 || (kind != "random" && kind != "geometric")) usage(argv[0]);
+
+    // Build the graph as CSR, the storage every relabeled copy ends up in
+    mt19937 rng(seed);
+    vector<Edge> edges = kind == "random" ? random_edges(V, deg, rng) : geometric_edges(V, deg, rng);
+    Graph g = Graph::forEdges(V, (long long)edges.size(), false, true);
+    g.addEdges(edges);
+    g.convertTo(GraphStorage::CSR);
+    cout << kind << " graph: " << V << " vertices, " << g.edgeCount() << " edges\n\n";
+
+    cout << "order    relabel_s  mean_span  compressed_B    SCC_s  Cliques_s      MST_s\n";
+    for (VertexOrder o : orders) {
+        unique_ptr<ReorderedGraph> r;
+        double tRelabel = seconds([&] { r = make_unique<ReorderedGraph>(g, o); });
+        const Graph& h = r->graph();
+        Graph packed = h;
+        packed.convertTo(GraphStorage::Compressed);
+        size_t bytes = packed.visit([](const auto& m) -> size_t {
+            if constexpr (IsCompressed<decay_t<decltype(m)>>::value) return m.byteCount();
+            else return 0;
+        });
+        long long comps = 0, count = -1, mst = 0;
+        double tSCC = seconds([&] { auto c = algoSCC::scc(h); comps = c.empty() ? 0 : *max_element(c.begin(), c.end()) + 1; });
+        double tCliques = cliques ? seconds([&] { count = algoCliques::countCliques(h); }) : 0;
+        double tMST = seconds([&] { mst = algoMST::mstWeight(h); });
+        printf("%-7s %10.4f %10.1f %13zu %8.4f %10.4f %10.4f   (components %lld, cliques %lld, MST %lld)\n",
+               vertexOrderName(o), tRelabel, mean_span(h), bytes, tSCC, tCliques, tMST, comps, count, mst);
+    }
+    return 0;
+}
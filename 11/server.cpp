@@ -30,6 +30,18 @@
 #include <cstring>
 // Include graph class header
 #include "graph.h"
+// Include binary graph file header
+#include "graphFile.h"
+// Include graph memory policy header
+#include "graphMemory.h"
+// Include random graph generator header
+#include "graphGenerator.h"
+// Include implicit (seed-defined) graph header
+#include "graphImplicit.h"
+// Include streaming algorithms header
+#include "algoStream.h"
+// Include cache of shared graphs and results
+#include "ResultCache.h"
 // Include algorithms header
 #include "Algorithms.h"
 // Include algorithm factory header
@@ -52,6 +64,31 @@ static string run_algo_by_name(const string& name, const Graph& g) {
     return strat->run(g);
 }
 
+// Graphs and results of recent requests, shared by all worker threads
+static ResultCache g_cache;
+
+// How random graphs pick their edges: on all cores, the same graph for any core count
+// (--legacy-random: the V*V shuffle of earlier versions)
+static EdgeSampling g_sampling = EdgeSampling::Counter;
+
+// Largest graph a request may ask for (--max-vertices, --max-edges): random and GEN graphs;
+// STREAM stores no edges and has its own, higher edge limit (--max-stream-edges)
+static GraphBudget g_budget;
+
+// Directory LOAD requests may read graph files from (--graph-dir); LOAD is refused without one
+static std::string g_graph_dir;
+
+// Reply to a request whose graph is over the budget of maxEdges edges
+static std::string over_budget(const char* what, long long maxEdges = g_budget.maxEdges) {
+    return std::string("Error: ") + what + " request over the server budget (V <= " +
+           std::to_string(g_budget.maxVertices) + ", E <= " + std::to_string(maxEdges) + ").\n";
+}
+
+// Build a random undirected graph with V vertices and E edges using seed S
+static Graph build_random_graph(int V, int E, int S) {
+    return GraphGenerator::random(V, E, static_cast<uint32_t>(S), g_sampling);
+}
+
 // Global server socket and control flags
 static int g_server_fd = -1;
 static sockaddr_in g_address{};
@@ -89,6 +126,81 @@ static void handle_client(int new_socket) {
     // Null-terminate the received string
     buffer[n] = '\0';
 
+    // "LOAD <name>": run the algorithms on a binary graph file of the --graph-dir directory instead
+    // of a random graph. The file is verified in full, as anyone may have written it.
+    if (std::strncmp(buffer, "LOAD ", 5) == 0) {
+        std::string name, path;
+        std::istringstream(buffer + 5) >> name;
+        Graph g(1);
+        std::string response;
+        if (g_graph_dir.empty())
+            response = "Error: LOAD is disabled (start the server with --graph-dir).\n";
+        else if (!GraphFile::inDirectory(g_graph_dir, name, path))
+            response = "Error: '" + name + "' is not a graph file name in the graph directory.\n";
+        else if (!GraphFile::open(path, g, true))
+            response = "Error: cannot load graph file '" + name + "'.\n";
+        else
+            // Results are shared with any earlier request for the same graph (fingerprint)
+            for (const auto& name : algoNames)
+                response += g_cache.result(g, name, [&] { return run_algo_by_name(name, g); });
+        ::send(new_socket, response.c_str(), response.size(), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        ::close(new_socket);
+        return;
+    }
+
+    // "GEN <family> <V> <E> <S> [options]": run the algorithms on a benchmark graph family
+    if (std::strncmp(buffer, "GEN ", 4) == 0) {
+        GeneratorSpec spec;
+        std::istringstream in(buffer + 4);
+        std::string response;
+        if (!GraphGenerator::parseSpec(in, spec)) {
+            response = "Error: bad GEN request (GEN <gnm|rmat|ba|clique|grid> <V> <E> <S> [k=..] [w=..] [a=.. b=.. c=..]).\n";
+        } else if (!g_budget.allows(spec.V, GraphGenerator::edgeBound(spec))) {
+            response = over_budget("GEN");
+        } else {
+            // Built once per spec and shared with every request for the same one
+            SharedGraph g = *g_cache.graph("GEN " + spec.str(), [&](Graph& out) { out = GraphGenerator::generate(spec); return true; });
+            for (const auto& name : algoNames)
+                response += g_cache.result(*g, name, [&] { return run_algo_by_name(name, *g); });
+        }
+        ::send(new_socket, response.c_str(), response.size(), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        ::close(new_socket);
+        return;
+    }
+
+    // "STREAM <V> <E> <S> [w=<max weight>]": answer from the seed alone; the edges are regenerated
+    // on every pass and never stored, so it runs in O(V) memory. Time grows with E, so E is held
+    // to --max-stream-edges (far above the limit for stored graphs) and V to --max-vertices.
+    if (std::strncmp(buffer, "STREAM ", 7) == 0) {
+        std::istringstream in(buffer + 7);
+        long long V = 0, E = 0;
+        uint64_t S = 0;
+        int maxWeight = 1;
+        std::string opt, response;
+        bool ok = bool(in >> V >> E >> S);
+        if (ok && in >> opt)
+            ok = opt.compare(0, 2, "w=") == 0 && (maxWeight = std::atoi(opt.c_str() + 2)) >= 1;
+        if (!ok || V <= 0 || V > INT32_MAX || E < 0 || E > V * (V - 1) / 2) {
+            response = "Error: bad STREAM request (STREAM <V> <E> <S> [w=<max weight>], E <= V(V-1)/2).\n";
+        } else if (!g_budget.allowsStream(V, E)) {
+            response = over_budget("STREAM", g_budget.maxStreamEdges);
+        } else {
+            ImplicitGraph g((int)V, E, S, maxWeight);
+            long long w = algoStream::mstWeight(g);
+            response = "Implicit graph: " + std::to_string(V) + " vertices, " + std::to_string(E) + " edges (not stored)\n";
+            response += w < 0 ? "MST: graph is not connected (no spanning tree).\n" : "MST total weight = " + std::to_string(w) + "\n";
+            response += "Connected components = " + std::to_string(algoStream::components(g)) + "\n";
+            response += "Odd degree vertices = " + std::to_string(algoStream::oddDegreeCount(g)) + "\n";
+            response += algoStream::hasEulerCircuit(g) ? "there is Euler Circuit in the graph\n" : "there is not Euler Circuit in the graph\n";
+        }
+        ::send(new_socket, response.c_str(), response.size(), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        ::close(new_socket);
+        return;
+    }
+
     // Variables for vertices, edges, seed, and algorithm name
     int V = 0, E = 0, S = 0;
     std::string A;
@@ -113,42 +225,32 @@ static void handle_client(int new_socket) {
 
     std::string response;
 
-    // Check if requested edges exceed maximum for simple undirected graph
+    // Check if requested edges exceed maximum for simple undirected graph, and the graph the budget
     long long maxEdges = 1LL * V * (V - 1) / 2;
-    if (E > maxEdges) {
-        response = "Error: requested edges (" + std::to_string(E) +
-                   ") exceed maximum for simple undirected graph (" +
-                   std::to_string(maxEdges) + ").\n";
+    if (V <= 0 || E < 0 || E > maxEdges || !g_budget.allows(V, E)) {
+        if (V <= 0 || E < 0)
+            response = "Error: bad request (<V> <E> <S>, V > 0, E >= 0).\n";
+        else if (E > maxEdges)
+            response = "Error: requested edges (" + std::to_string(E) +
+                       ") exceed maximum for simple undirected graph (" +
+                       std::to_string(maxEdges) + ").\n";
+        else
+            response = over_budget("random graph");
         ::send(new_socket, response.c_str(), response.size(), 0);
         ::close(new_socket);
         return;
     }
 
-    // Build random graph
-    std::mt19937 gen(static_cast<unsigned int>(S));
-    std::vector<std::pair<int,int>> AllEdges;
-    AllEdges.reserve((size_t)V * (size_t)V);
-    for (int i = 0; i < V; i++)
-        for (int j = 0; j < V; j++)
-            AllEdges.push_back({i, j});
-
-    std::shuffle(AllEdges.begin(), AllEdges.end(), gen);
-
-    // Create an undirected graph with V vertices
-    Graph g(V);
-    int added = 0;
-    // Add edges to the graph until reaching E edges
-    for (size_t i = 0; i < AllEdges.size() && added < E; ++i) {
-        int u = AllEdges[i].first;
-        int v = AllEdges[i].second;
-        // Add edge if possible (no duplicates/self-loops)
-        if (g.addEdge(u, v))
-            ++added;
-    }
+    // Build the random graph, or share the one an earlier request with the same V, E, S built
+    std::string key = std::to_string(V) + " " + std::to_string(E) + " " + std::to_string(S);
+    SharedGraph g = *g_cache.graph(key, [&](Graph& out) { out = build_random_graph(V, E, S); return true; });
+    // Report where a graph large enough for its own mapping was placed
+    if (g->placement().mapped)
+        std::cout << "[mem] " << key << ": " << g->placement().describe() << std::endl;
 
-    // Run all algorithms and append results to response
+    // Run all algorithms (or reuse the output cached for an identical graph) and append results to response
     for (const auto& name : algoNames)
-        response += run_algo_by_name(name, g);
+        response += g_cache.result(*g, name, [&] { return run_algo_by_name(name, *g); });
 
     // Send response to client and close connection
     ::send(new_socket, response.c_str(), response.size(), 0);
@@ -193,7 +295,25 @@ static void worker_loop() {
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Parse --huge <none|thp|explicit> and --numa <default|interleave|bind:N> for graph memory,
+    // --legacy-random to get the graphs earlier versions built for the same seeds, and
+    // --max-vertices / --max-edges for the largest graph one request may build,
+    // --max-stream-edges for the largest graph one STREAM request may regenerate, and
+    // --graph-dir for the directory LOAD requests read from
+    std::string huge, numa;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--huge" && i + 1 < argc) huge = argv[++i];
+        else if (a == "--numa" && i + 1 < argc) numa = argv[++i];
+        else if (a == "--legacy-random") g_sampling = EdgeSampling::ShuffleAll;
+        else if (a == "--max-vertices" && i + 1 < argc) g_budget.maxVertices = std::atoll(argv[++i]);
+        else if (a == "--graph-dir" && i + 1 < argc) g_graph_dir = argv[++i];
+        else if (a == "--max-edges" && i + 1 < argc) g_budget.maxEdges = std::atoll(argv[++i]);
+        else if (a == "--max-stream-edges" && i + 1 < argc) g_budget.maxStreamEdges = std::atoll(argv[++i]);
+    }
+    if (!GraphMemory::configure(huge, numa)) return 1;
+
     // Register SIGINT handler for graceful shutdown
     std::signal(SIGINT, handle_sigint);
 